@@ -4,6 +4,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -40,11 +41,17 @@ namespace bufr {
 
         /// \brief Uses the provided description to parse the buffer file.
         /// \param maxMsgsToParse Messages to parse (0 for everything)
-        std::shared_ptr<DataContainer> parse(const size_t maxMsgsToParse = 0);
+        /// \param categories _optional_ Only parse these categories (one name per split in each
+        ///        category id). Subsets of other categories are skipped as the file is read.
+        std::shared_ptr<DataContainer> parse(const size_t maxMsgsToParse = 0,
+                                             const std::vector<SubCategory>& categories = {});
 
         /// \brief Uses the provided description to parse the BUFR file using MPI.
         /// \param comm The eckit MPI comm object
-        std::shared_ptr<DataContainer> parse(const eckit::mpi::Comm&);
+        /// \param categories _optional_ Only parse these categories (one name per split in each
+        ///        category id).
+        std::shared_ptr<DataContainer> parse(const eckit::mpi::Comm&,
+                                             const std::vector<SubCategory>& categories = {});
 
         /// \brief Start over from beginning of the BUFR file
         void reset();
@@ -58,9 +65,22 @@ namespace bufr {
         /// \brief The Bufr file object we are working with
         File file_;
 
+        /// \brief Make the QuerySet for the description (including any filter or category
+        ///        predicates).
+        /// \param categories The categories to parse (empty for all of them).
+        QuerySet makeQuerySet(const std::vector<SubCategory>& categories) const;
+
         /// \brief Exports collected data into a DataContainer
         /// \param srcData Data to export
-        std::shared_ptr<DataContainer> exportData(const BufrDataMap& srcData);
+        /// \param categories The categories to export (empty for all of them).
+        std::shared_ptr<DataContainer> exportData(const BufrDataMap& srcData,
+                                                  const std::vector<SubCategory>& categories);
+
+        /// \brief Get the requested category names for each split.
+        /// \param categories The requested category ids (one name per split).
+        /// \result One set of names per split (empty if no categories were requested).
+        std::vector<std::set<std::string>> splitNames(
+            const std::vector<SubCategory>& categories) const;
 
         /// \brief Function responsible for dividing the data into subcategories.
         /// \details This function is intended to be called over and over for each specified Split
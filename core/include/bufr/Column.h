@@ -0,0 +1,117 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#pragma once
+
+#include <memory>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "DataObject.h"
+
+namespace bufr {
+    /// \brief The values of a field as a contiguous array of a concrete type, with one validity
+    ///        byte per value (1 if the value is valid).
+    /// \details The type is resolved once when the column is made, so code that uses it can be
+    ///          written as plain loops over arrays instead of making virtual calls for every
+    ///          element. The field's own storage is used when it already has type T, otherwise
+    ///          the values are converted (missing values become DataObject<T>::missingValue()).
+    template <typename T>
+    class Column
+    {
+     public:
+        /// \brief Constructor
+        /// \param object The (numeric) field to make the column for.
+        explicit Column(const std::shared_ptr<DataObjectBase>& object) :
+            object_(object)
+        {
+            if (!(resolve<T>() || resolve<float>() || resolve<double>() || resolve<int32_t>() ||
+                  resolve<uint32_t>() || resolve<int64_t>() || resolve<uint64_t>()))
+            {
+                std::ostringstream errStr;
+                errStr << "Field " << object_->getFieldName() << " does not contain numbers.";
+                throw eckit::BadParameter(errStr.str());
+            }
+        }
+
+        Column(const Column&) = delete;
+        Column(Column&&) = default;
+        Column& operator=(const Column&) = delete;
+        Column& operator=(Column&&) = default;
+
+        /// \brief The number of values.
+        inline size_t size() const { return size_; }
+
+        /// \brief Pointer to the values.
+        inline const T* data() const { return values_; }
+
+        /// \brief Pointer to the validity bytes (one per value).
+        inline const char* validity() const { return valid_.data(); }
+
+        /// \brief The value at the index.
+        inline T operator[](size_t idx) const { return values_[idx]; }
+
+        /// \brief Is the value at the index valid (not missing).
+        inline bool isValid(size_t idx) const { return valid_[idx]; }
+
+        /// \brief The field the column was made from.
+        inline const std::shared_ptr<DataObjectBase>& object() const { return object_; }
+
+     private:
+        std::shared_ptr<DataObjectBase> object_;
+        std::vector<T> converted_;
+        std::vector<char> valid_;
+        const T* values_ = nullptr;
+        size_t size_ = 0;
+
+        /// \brief Make the column if the field has type U.
+        /// \result true if the field has type U.
+        template <typename U>
+        bool resolve()
+        {
+            auto typedObject = std::dynamic_pointer_cast<DataObject<U>>(object_);
+            if (!typedObject) return false;
+
+            const auto& src = typedObject->getRawDataRef();
+            size_ = src.size();
+
+            valid_.resize(size_);
+            if (typedObject->hasValidityBitmap())
+            {
+                const auto& bits = typedObject->getValidityBitmap();
+                for (size_t idx = 0; idx < size_; ++idx)
+                {
+                    valid_[idx] = static_cast<char>((bits[idx >> 6] >> (idx & 63)) & 1);
+                }
+            }
+            else
+            {
+                const U missing = DataObject<U>::missingValue();
+                for (size_t idx = 0; idx < size_; ++idx)
+                {
+                    valid_[idx] = static_cast<char>(src[idx] != missing);
+                }
+            }
+
+            if constexpr (std::is_same<T, U>::value)
+            {
+                values_ = src.data();
+            }
+            else
+            {
+                const T missing = DataObject<T>::missingValue();
+                converted_.resize(size_);
+                for (size_t idx = 0; idx < size_; ++idx)
+                {
+                    converted_[idx] = valid_[idx] ? static_cast<T>(src[idx]) : missing;
+                }
+
+                values_ = converted_.data();
+            }
+
+            return true;
+        }
+    };
+}  // namespace bufr
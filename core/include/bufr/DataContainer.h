@@ -96,6 +96,13 @@ namespace bufr {
     /// \param comm MPI communicator to use.
     void gather(const eckit::mpi::Comm& comm);
 
+    /// \brief Redistribute the data so every category is whole on one rank (the categories
+    ///        are balanced across the ranks by their number of rows). Each rank is left with
+    ///        only the categories it owns, so the ranks can encode their categories at the same
+    ///        time. All ranks must have the same categories (like for gather).
+    /// \param comm MPI communicator to use.
+    void distributeCategories(const eckit::mpi::Comm& comm);
+
   private:
     /// Category map given (see constructor).
     CategoryMap categoryMap_;
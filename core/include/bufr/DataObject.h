@@ -8,9 +8,16 @@
 #pragma once
 
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <type_traits>
 #include <memory>
+#include <mutex>
 #include <iostream>
+#include <unordered_map>
 #include <vector>
 #include <netcdf>
 
@@ -100,7 +107,53 @@ namespace bufr {
     }
   };
 
-  class DataObjectBase
+  /// \brief Convert raw BUFR octet values to T in a single branch free pass. Values equal to the
+  ///        BUFR missing value become the given missing value and have their bit in the packed
+  ///        validity bitmap cleared (all other bits are set).
+  /// \param src The raw BUFR values.
+  /// \param size The number of values.
+  /// \param dst Destination buffer with room for size values.
+  /// \param validity Destination bitmap with room for (size + 63) / 64 words.
+  /// \param missing The value to use for missing data.
+  template<typename T>
+  inline void convertOctets(const double* src, size_t size, T* dst, uint64_t* validity, T missing)
+  {
+    const double Tolerance = std::numeric_limits<double>::epsilon() * MissingOctetValue * 100;
+
+    for (size_t start = 0; start < size; start += 64)
+    {
+      const size_t end = std::min(start + 64, size);
+
+      uint64_t bits = 0;
+      for (size_t idx = start; idx < end; ++idx)
+      {
+        const double value = src[idx];
+        const bool isMissing = std::fabs(value - MissingOctetValue) <= Tolerance;
+
+        // Never cast the missing value itself as it can be out of range for integer types.
+        dst[idx] = isMissing ? missing : static_cast<T>(isMissing ? 0.0 : value);
+        bits |= static_cast<uint64_t>(!isMissing) << (idx - start);
+      }
+
+      validity[start / 64] = bits;
+    }
+  }
+
+  // Versions of convertOctets for the common types which are compiled for several instruction sets
+  // (AVX-512, AVX2 and baseline where supported) with the best one being picked at runtime.
+  void convertOctets(const double* src, size_t size, float* dst, uint64_t* validity, float missing);
+  void convertOctets(const double* src, size_t size, double* dst, uint64_t* validity,
+                     double missing);
+  void convertOctets(const double* src, size_t size, int32_t* dst, uint64_t* validity,
+                     int32_t missing);
+  void convertOctets(const double* src, size_t size, uint32_t* dst, uint64_t* validity,
+                     uint32_t missing);
+  void convertOctets(const double* src, size_t size, int64_t* dst, uint64_t* validity,
+                     int64_t missing);
+  void convertOctets(const double* src, size_t size, uint64_t* dst, uint64_t* validity,
+                     uint64_t missing);
+
+  class DataObjectBase : public std::enable_shared_from_this<DataObjectBase>
   {
     public:
       DataObjectBase() = default;
@@ -155,13 +208,25 @@ namespace bufr {
       /// \param val Scalar to add to the data..
       virtual void offsetBy(double val) = 0;
 
+      /// \brief Replace every non-missing value x with scale * x + offset in a single pass.
+      /// \param scale Scalar to multiply the data by.
+      /// \param offset Scalar to add to the data after scaling.
+      virtual void scaleAndOffset(double scale, double offset) = 0;
+
       /// \brief Write the data out using a writer.
       /// \param writer The writer to use.
       virtual void write(std::shared_ptr<ObjectWriterBase> writer) = 0;
 
       /// \brief Do an MPI Gather operation and accumalate the data into the root process.
       /// \param comm The MPI communicator to use.
-      virtual void gather(const eckit::mpi::Comm& comm) = 0;
+      /// \param root The rank to gather the data into.
+      virtual void gather(const eckit::mpi::Comm& comm, size_t root = 0) = 0;
+
+      /// \brief Make the extra dimensions (not the first one) the same on all the ranks (the
+      ///        largest of each), padding the data with missing values. The ranks can then
+      ///        write their rows into one shared variable.
+      /// \param comm The MPI communicator to use.
+      virtual void alignDims(const eckit::mpi::Comm& comm) = 0;
 
       /// \brief Makes a new dimension scale using this data object as the source
       /// \param name The name of the dimension variable.
@@ -172,6 +237,35 @@ namespace bufr {
 
       virtual std::shared_ptr<DataObjectBase> slice(const std::vector<std::size_t>& rows) const = 0;
 
+      /// \brief Make a lightweight view of some of the rows of this object. The view shares
+      ///        this object's data and only copies its rows out when they are first needed (for
+      ///        example when written by an encoder or exported to python). A view of a view
+      ///        refers directly to the original data. The viewed object must not be modified
+      ///        while views of it exist. A view may be read from several threads at once (the
+      ///        rows are only copied out once).
+      /// \param rows The indices of the rows to view.
+      /// \return View of the rows.
+      virtual std::shared_ptr<DataObjectBase> view(const std::vector<std::size_t>& rows) const = 0;
+
+      /// \brief Is this object a view whose data still lives in another object.
+      bool isView() const { return viewPending_.load(std::memory_order_acquire); }
+
+      /// \brief Copy the viewed rows into this object so it owns its data (no-op if it does).
+      ///        Concurrent readers wait for the first one to finish the copy.
+      void materialize() const
+      {
+        if (viewPending_.load(std::memory_order_acquire))
+        {
+          std::lock_guard<std::mutex> lock(viewMutex_);
+          if (viewParent_)
+          {
+            materializeView();
+          }
+
+          viewPending_.store(false, std::memory_order_release);
+        }
+      }
+
       virtual size_t size() const = 0;
 
       size_t idxFromLoc(const Location& loc) const
@@ -224,6 +318,159 @@ namespace bufr {
       std::vector<int> dims_;
       std::string query_;
       std::vector<Query> dimPaths_;
+
+      /// The object this object is a view of (nullptr if it owns its data) and the viewed rows.
+      mutable std::shared_ptr<const DataObjectBase> viewParent_;
+      mutable std::vector<std::size_t> viewRows_;
+
+      /// Guards the view members while the view is materialized. viewPending_ is set while the
+      /// data still lives in viewParent_ so owning objects never need to take the lock.
+      mutable std::mutex viewMutex_;
+      mutable std::atomic<bool> viewPending_{false};
+
+      /// \brief Copy the viewed rows out of viewParent_ and release it.
+      virtual void materializeView() const = 0;
+
+      /// \brief Forget the view (used when the data is about to be replaced).
+      void dropView()
+      {
+        viewParent_.reset();
+        std::vector<std::size_t>().swap(viewRows_);
+        viewPending_.store(false, std::memory_order_release);
+      }
+
+      /// \brief Turn a new empty object of the same type into a view of rows of this object.
+      void initView(DataObjectBase& viewObject, const std::vector<std::size_t>& rows) const
+      {
+        viewObject.fieldName_ = fieldName_;
+        viewObject.groupByFieldName_ = groupByFieldName_;
+        viewObject.dims_ = dims_;
+        viewObject.dims_[0] = rows.size();
+        viewObject.query_ = query_;
+        viewObject.dimPaths_ = dimPaths_;
+        viewObject.viewPending_.store(true, std::memory_order_release);
+
+        std::lock_guard<std::mutex> lock(viewMutex_);
+        if (viewParent_)
+        {
+          viewObject.viewParent_ = viewParent_;
+          viewObject.viewRows_.resize(rows.size());
+          for (size_t idx = 0; idx < rows.size(); ++idx)
+          {
+            viewObject.viewRows_[idx] = viewRows_[rows[idx]];
+          }
+        }
+        else
+        {
+          viewObject.viewParent_ = shared_from_this();
+          viewObject.viewRows_ = rows;
+        }
+      }
+
+      /// \brief Make the number of dimensions consistent across all ranks and compute the
+      ///        global dimensions (sum of the first dimension and max of the others).
+      std::vector<int> gatherDims(const eckit::mpi::Comm& comm, size_t root = 0)
+      {
+        size_t numDims = dims_.size();
+        comm.reduce(numDims, numDims, eckit::mpi::Operation::MAX, root);
+
+        // Ensure all ranks have the same number of dimensions
+        if (numDims != dims_.size())
+        {
+          int missingDims = numDims - dims_.size();
+          for (int idx = 0; idx < missingDims; ++idx)
+          {
+            dims_.insert(dims_.end() - 1, 1);
+          }
+        }
+
+        std::vector<int> rcvDims = dims_;
+        comm.reduce(rcvDims[0], rcvDims[0], eckit::mpi::Operation::SUM, root);
+
+        for (size_t i = 1; i < numDims; ++i)
+        {
+          comm.allReduce(rcvDims[i], rcvDims[i], eckit::mpi::Operation::MAX);
+        }
+
+        return rcvDims;
+      }
+
+      /// \brief Make the number of dimensions consistent across all ranks and get the global
+      ///        extra dimensions (the max of each). The first dimension stays the local one.
+      std::vector<int> alignedDims(const eckit::mpi::Comm& comm)
+      {
+        size_t numDims = dims_.size();
+        comm.allReduce(numDims, numDims, eckit::mpi::Operation::MAX);
+
+        // Ensure all ranks have the same number of dimensions
+        if (numDims != dims_.size())
+        {
+          int missingDims = numDims - dims_.size();
+          for (int idx = 0; idx < missingDims; ++idx)
+          {
+            dims_.insert(dims_.end() - 1, 1);
+          }
+        }
+
+        std::vector<int> globalDims = dims_;
+        for (size_t i = 1; i < numDims; ++i)
+        {
+          comm.allReduce(globalDims[i], globalDims[i], eckit::mpi::Operation::MAX);
+        }
+
+        return globalDims;
+      }
+
+      /// \brief Resize a buffer so its extra dimensions (not the first one) match the global
+      ///        ones, filling with the given value where necessary.
+      template<typename U>
+      void padToDims(std::vector<U>& buffer, const std::vector<int>& rcvDims, const U& fill) const
+      {
+        size_t sendSize = dims_[0];
+        for (size_t idx = 1; idx < rcvDims.size(); idx++)
+        {
+          sendSize *= rcvDims[idx];
+        }
+
+        // Do the extra dimensions from the different ranks match?
+        bool adjustDims = false;
+        for (size_t idx = 1; idx < rcvDims.size(); idx++)
+        {
+          adjustDims = adjustDims || (rcvDims[idx] != dims_[idx]);
+        }
+
+        // Resize the dimensions to match the global dimensions
+        if (adjustDims)
+        {
+          std::vector<U> sendBuffer(sendSize, fill);
+
+          // Map the local data into the sendBuffer using the (row major) dimensions
+          for (size_t i = 0; i < buffer.size(); ++i)
+          {
+            Location loc(dims_.size(), 0);
+
+            // Compute the location coordinate in the old data
+            size_t idx = i;
+            for (size_t dimIdx = dims_.size(); dimIdx-- > 0;)
+            {
+              loc[dimIdx] = idx % dims_[dimIdx];
+              idx /= dims_[dimIdx];
+            }
+
+            // Map that location into the new data (compute the new index)
+            idx = 0;
+            for (size_t dimIdx = 0; dimIdx < rcvDims.size(); ++dimIdx)
+            {
+              const size_t dimSize = (dimIdx == 0) ? dims_[0] : rcvDims[dimIdx];
+              idx = idx * dimSize + loc[dimIdx];
+            }
+
+            sendBuffer[idx] = buffer[i];
+          }
+
+          buffer = std::move(sendBuffer);
+        }
+      }
   };
 
   template <typename T>
@@ -235,13 +482,19 @@ namespace bufr {
       /// \return copy
       std::shared_ptr<DataObjectBase> copy() const final
       {
+        std::lock_guard<std::mutex> lock(viewMutex_);
         auto copy = std::make_shared<DataObject<T>>();
         copy->data_ = data_;
+        copy->validity_ = validity_;
+        copy->hasValidity_ = hasValidity_;
         copy->fieldName_ = fieldName_;
         copy->groupByFieldName_ = groupByFieldName_;
         copy->dims_ = dims_;
         copy->query_ = query_;
         copy->dimPaths_ = dimPaths_;
+        copy->viewParent_ = viewParent_;
+        copy->viewRows_ = viewRows_;
+        copy->viewPending_.store(viewParent_ != nullptr, std::memory_order_release);
         return copy;
       }
 
@@ -256,6 +509,7 @@ namespace bufr {
       /// \brief Print the data object to a output stream.
       void print(std::ostream& out) const final
       {
+        materialize();
         out << "DataObject " << fieldName_ << " " << groupByFieldName_ << " ";
         out << "size " << data_.size() << std::endl;
 
@@ -303,6 +557,7 @@ namespace bufr {
       /// \return Int data.
       int getAsInt(size_t idx) const final
       {
+        materialize();
         return static_cast<int>(data_[idx]);
       }
 
@@ -310,6 +565,7 @@ namespace bufr {
       /// \return Float data.
       float getAsFloat(size_t idx) const final
       {
+        materialize();
         return static_cast<float>(data_[idx]);
       }
 
@@ -317,6 +573,7 @@ namespace bufr {
       /// \return String data.
       std::string getAsString(size_t idx) const final
       {
+        materialize();
         return std::to_string(data_[idx]);
       }
 
@@ -324,6 +581,12 @@ namespace bufr {
       /// \return bool data.
       bool isMissing(size_t idx) const final
       {
+        materialize();
+        if (hasValidity_)
+        {
+          return !testBit(validity_, idx);
+        }
+
         return data_[idx] == missingValue();
       }
 
@@ -332,6 +595,7 @@ namespace bufr {
       /// \return The data at the given location.
       T get(const Location& loc) const
       {
+        materialize();
         return data_[idxFromLoc(loc)];
       };
 
@@ -339,37 +603,45 @@ namespace bufr {
       /// \param val Scalar to multiply to the data..
       void multiplyBy(double val) final
       {
-        if (typeid(T) == typeid(float) ||   // NOLINT
-            typeid(T) == typeid(double) ||  // NOLINT
-            trunc(val) == val)
-        {
-          for (size_t i = 0; i < data_.size(); i++)
-          {
-            if (data_[i] != missingValue())
-            {
-              data_[i] = static_cast<T>(static_cast<double>(data_[i]) * val);
-            }
-          }
-        }
-        else
-        {
-          std::ostringstream str;
-          str << "Multiplying integer field \"" << fieldName_ << "\" with a non-integer is ";
-          str << "illegal. Please convert it to a float or double.";
-          throw eckit::BadParameter(str.str());
-        }
+        scaleAndOffset(val, 0.0);
       }
 
       /// \brief Add a scalar to the stored values in this data object.
       /// \param val Scalar to add to the data.
       void offsetBy(double val) final
       {
-        for (size_t i = 0; i < data_.size(); i++)
+        scaleAndOffset(1.0, val);
+      }
+
+      /// \brief Replace every non-missing value x with scale * x + offset in a single pass.
+      /// \param scale Scalar to multiply the data by.
+      /// \param offset Scalar to add to the data after scaling.
+      void scaleAndOffset(double scale, double offset) final
+      {
+        materialize();
+        if constexpr (std::is_floating_point<T>::value)
+        {
+          applyAffine([scale, offset](T value)
+          {
+            return static_cast<T>(static_cast<double>(value) * scale + offset);
+          });
+        }
+        else
         {
-          if (data_[i] != missingValue())
+          if (std::trunc(scale) != scale)
           {
-            data_[i] = data_[i] + static_cast<T>(val);
+            std::ostringstream str;
+            str << "Multiplying integer field \"" << fieldName_ << "\" with a non-integer is ";
+            str << "illegal. Please convert it to a float or double.";
+            throw eckit::BadParameter(str.str());
           }
+
+          const auto intScale = static_cast<T>(scale);
+          const auto intOffset = static_cast<T>(offset);
+          applyAffine([intScale, intOffset](T value)
+          {
+            return static_cast<T>(value * intScale + intOffset);
+          });
         }
       }
 
@@ -386,34 +658,87 @@ namespace bufr {
         }
         else
         {
+          dropView();
           data_ = std::vector<T>(data.size());
-          for (size_t idx = 0; idx < data.size(); ++idx)
-          {
-            if (!data.isMissing(idx))
-            {
-              data_[idx] = data.value.octets[idx];
-            }
-            else
-            {
-              data_[idx] = missingValue();
-            }
-          }
+          validity_.assign(numWords(data.size()), 0);
+          hasValidity_ = true;
+          convertOctets(data.value.octets.data(),
+                        data.size(),
+                        data_.data(),
+                        validity_.data(),
+                        missingValue());
         }
       }
 
       // \brief Set the data associated with this data object.
       void setData(const std::vector<T>& data)
       {
+        dropView();
+        data_ = data;
+        validity_.clear();
+        hasValidity_ = false;
+      }
+
+      /// \brief Set the data along with a packed validity bitmap (bit set means valid). Valid
+      ///        values may equal missingValue, but the NetCDF encoder can only mark missing values
+      ///        with the _FillValue (the missing value), so such values read back as missing from
+      ///        the files it writes.
+      /// \param data The raw data
+      /// \param validity One bit per element packed into 64 bit words.
+      void setData(const std::vector<T>& data, const std::vector<uint64_t>& validity)
+      {
+        if (validity.size() != numWords(data.size()))
+        {
+          std::ostringstream str;
+          str << "Validity bitmap for field " << fieldName_ << " has the wrong size.";
+          throw eckit::BadParameter(str.str());
+        }
+
+        dropView();
         data_ = data;
+        validity_ = validity;
+        hasValidity_ = true;
+      }
+
+      /// \brief Build the validity bitmap from the missing value sentinel.
+      void buildValidityBitmap()
+      {
+        materialize();
+        validity_ = validityFromSentinel();
+        hasValidity_ = true;
+      }
+
+      /// \brief Is there a validity bitmap for this object.
+      bool hasValidityBitmap() const
+      {
+        materialize();
+        return hasValidity_;
+      }
+
+      /// \brief Get the packed validity bitmap (only valid if hasValidityBitmap).
+      const std::vector<uint64_t>& getValidityBitmap() const
+      {
+        materialize();
+        return validity_;
       }
 
       /// \brief Write the data out using a writer.
       /// \param writer The writer to use.
       void write(std::shared_ptr<ObjectWriterBase> writer) final
       {
+        materialize();
         if (auto writerPtr = std::dynamic_pointer_cast<ObjectWriter<T>>(writer))
         {
-          writerPtr->write(data_);
+          // Writers only know about the missing value, so put it wherever the bitmap says a
+          // value is missing (only copying the data if some of those hold something else).
+          if (hasUnfilledMissing())
+          {
+            writerPtr->write(dataWithMissingFilled());
+          }
+          else
+          {
+            writerPtr->write(data_);
+          }
         }
         else
         {
@@ -426,34 +751,21 @@ namespace bufr {
 
       /// \brief Do an MPI Gather operation and accumalate the data into the root process.
       /// \param comm The MPI communicator to use.
-      void gather(const eckit::mpi::Comm& comm) final
+      /// \param root The rank to gather the data into.
+      void gather(const eckit::mpi::Comm& comm, size_t root = 0) final
       {
-        size_t numDims = dims_.size();
-        comm.reduce(numDims, numDims, eckit::mpi::Operation::MAX, 0);
-
-        // Ensure all ranks have the same number of dimensions
-        if (numDims != dims_.size())
-        {
-          int missingDims = numDims - dims_.size();
-          for (int idx = 0; idx < missingDims; ++idx)
-          {
-            dims_.insert(dims_.end() - 1, 1);
-          }
-        }
-
-        std::vector<int> rcvDims = dims_;
-        comm.reduce(rcvDims[0], rcvDims[0], eckit::mpi::Operation::SUM, 0);
+        materialize();
+        // If any rank has a validity bitmap then the result should have one as well.
+        int withValidity = hasValidity_ ? 1 : 0;
+        comm.allReduce(withValidity, withValidity, eckit::mpi::Operation::MAX);
 
-        for (size_t i = 1; i < numDims; ++i)
+        std::vector<char> valid;
+        if (withValidity)
         {
-          comm.allReduce(rcvDims[i], rcvDims[i], eckit::mpi::Operation::MAX);
+          valid = unpackValidity();
         }
 
-        size_t sendSize = dims_[0];
-        for (size_t idx = 1; idx < rcvDims.size(); idx++)
-        {
-          sendSize *= rcvDims[idx];
-        }
+        auto rcvDims = gatherDims(comm, root);
 
         size_t rcvSize = 1;
         for (size_t idx = 0; idx < rcvDims.size(); idx++)
@@ -464,50 +776,16 @@ namespace bufr {
         // Fix my send buffer if the global extra dimensions (not the first one) differ from my own
         // (resize and fill with missing values where necessary). This will involve creating a send
         // array and copying data into the correct indices.
-
-        // Do the extra dimensions from the different ranks match?
-        bool adjustDims = false;
-        for (size_t idx = 1; idx < rcvDims.size(); idx++)
-        {
-          adjustDims = (rcvDims[idx] != getDims()[idx]);
-        }
-
-        // Resize the dimensions to match the global dimensions
-        if (adjustDims)
+        padToDims(data_, rcvDims, missingValue());
+        if (withValidity)
         {
-          std::vector<T> sendBuffer(sendSize, missingValue());
-
-          // Map the local data into the sendBuffer using the dimensions
-          for (size_t i = 0; i < data_.size(); ++i)
-          {
-            Location loc;
-
-            // Compute the location coordinate in the old data
-            size_t idx = i;
-            for (size_t dimIdx = 0; dimIdx < dims_.size(); ++dimIdx)
-            {
-              loc.push_back(idx % dims_[dimIdx]);
-              idx /= dims_[dimIdx];
-            }
-
-            // Map that location into the new data (compute the new index)
-            idx = 0;
-            for (size_t dimIdx = 0; dimIdx < rcvDims.size(); ++dimIdx)
-            {
-              idx += loc[dimIdx] * rcvDims[dimIdx];
-            }
-
-            sendBuffer[idx] = data_[i];
-          }
-
-          data_ = std::move(sendBuffer);
+          padToDims(valid, rcvDims, static_cast<char>(0));
         }
 
         auto sizeArray = std::vector<int>(comm.size());
         comm.allGather(static_cast<int>(size()), sizeArray.begin(), sizeArray.end());
 
         std::vector<T> rcvBuffer(rcvSize, missingValue());
-        auto rcvCounts = std::vector<int>(comm.size());
 
         std::vector<int> displacement(comm.size(), 0);
         for (size_t i = 1; i < comm.size(); i++)
@@ -517,15 +795,16 @@ namespace bufr {
 
         if constexpr (!std::is_same_v<T, unsigned long long> && !std::is_same_v<T, unsigned int>)
         {
-          comm.gatherv(data_, rcvBuffer, sizeArray, displacement, 0);
+          comm.gatherv(data_, rcvBuffer, sizeArray, displacement, root);
         }
         else
         {
           // Use unsigned long as the type and use that to gatherv back to the correct type. This is
           // necessary because eckit MPI does not support unsigned long long or unsigned int
           std::vector<unsigned long> ulData(data_.begin(), data_.end());
-          std::vector<unsigned long> ulRcvBuffer(rcvSize, DataObject<unsigned long>::missingValue());
-          comm.gatherv(ulData, ulRcvBuffer, sizeArray, displacement, 0);
+          std::vector<unsigned long> ulRcvBuffer(rcvSize,
+                                                 DataObject<unsigned long>::missingValue());
+          comm.gatherv(ulData, ulRcvBuffer, sizeArray, displacement, root);
 
           // manually copy preserving missing values
           for (size_t i = 0; i < rcvSize; i++)
@@ -537,11 +816,52 @@ namespace bufr {
           }
         }
 
-        if (comm.rank() == 0)
+        std::vector<char> rcvValid;
+        if (withValidity)
+        {
+          rcvValid.assign(rcvSize, 0);
+          comm.gatherv(valid, rcvValid, sizeArray, displacement, root);
+        }
+
+        if (comm.rank() == root)
         {
           dims_ = rcvDims;
           data_ = std::move(rcvBuffer);
+
+          if (withValidity)
+          {
+            validity_.assign(numWords(data_.size()), 0);
+            for (size_t idx = 0; idx < rcvValid.size(); ++idx)
+            {
+              if (rcvValid[idx]) setBit(validity_, idx);
+            }
+
+            hasValidity_ = true;
+          }
+        }
+      }
+
+      /// \brief Make the extra dimensions the same on all the ranks (see DataObjectBase).
+      /// \param comm The MPI communicator to use.
+      void alignDims(const eckit::mpi::Comm& comm) final
+      {
+        materialize();
+        auto globalDims = alignedDims(comm);
+
+        if (hasValidity_)
+        {
+          auto valid = unpackValidity();
+          padToDims(valid, globalDims, static_cast<char>(0));
+
+          validity_.assign(numWords(valid.size()), 0);
+          for (size_t idx = 0; idx < valid.size(); ++idx)
+          {
+            if (valid[idx]) setBit(validity_, idx);
+          }
         }
+
+        padToDims(data_, globalDims, missingValue());
+        dims_ = globalDims;
       }
 
       /// \brief Append the data from another DataObject to this one.
@@ -556,6 +876,9 @@ namespace bufr {
           throw eckit::BadParameter(str.str());
         }
 
+        materialize();
+        other->materialize();
+
         dims_[0] += other->dims_[0];
         for (size_t i = 1; i < dims_.size(); ++i)
         {
@@ -566,6 +889,33 @@ namespace bufr {
             throw eckit::BadParameter(str.str());
           }
         }
+
+        if (hasValidity_ || other->hasValidity_)
+        {
+          auto validity = hasValidity_ ? std::move(validity_) : validityFromSentinel();
+          const auto& otherValidity = other->hasValidity_ ? other->validity_
+                                                          : other->validityFromSentinel();
+
+          // Shift the incoming bits into place after the existing ones.
+          const size_t offset = data_.size();
+          validity.resize(numWords(offset + other->data_.size()), 0);
+          for (size_t word = 0; word < otherValidity.size(); ++word)
+          {
+            const auto bits = otherValidity[word];
+            if (bits == 0) continue;
+
+            const size_t pos = offset + word * 64;
+            validity[pos >> 6] |= bits << (pos & 63);
+            if ((pos & 63) != 0 && (pos >> 6) + 1 < validity.size())
+            {
+              validity[(pos >> 6) + 1] |= bits >> (64 - (pos & 63));
+            }
+          }
+
+          validity_ = std::move(validity);
+          hasValidity_ = true;
+        }
+
         data_.insert(data_.end(), other->data_.begin(), other->data_.end());
       }
 
@@ -575,6 +925,7 @@ namespace bufr {
       std::shared_ptr<DimensionDataBase> createDimensionFromData(const std::string& name,
                                                                  std::size_t dimIdx) const final
       {
+        materialize();
         auto dimData = std::make_shared<DimensionData<T>>(name, getDims()[dimIdx]);
 
         if (data_.empty())
@@ -606,20 +957,43 @@ namespace bufr {
 
       /// \brief Get the raw data associated with this data object.
       /// \return The raw data.
-      std::vector<T> getRawData() const { return data_; }
+      std::vector<T> getRawData() const
+      {
+        materialize();
+        return data_;
+      }
+
+      /// \brief Get a reference to the raw data (avoids the copy made by getRawData).
+      /// \return The raw data.
+      const std::vector<T>& getRawDataRef() const
+      {
+        materialize();
+        return data_;
+      }
 
       /// \brief Get the size of the data object.
       /// \return The size of the data object.
       size_t size() const final
       {
-        return data_.size();
-      }
-
+        if (isView())
+        {
+          std::lock_guard<std::mutex> lock(viewMutex_);
+          if (viewParent_)
+          {
+            return viewParent_->size() / std::max<size_t>(viewParent_->getDims()[0], 1) *
+                   viewRows_.size();
+          }
+        }
+
+        return data_.size();
+      }
+
       /// \brief Slice the data object according to a list of indices.
       /// \param rows The indices to slice the data object by.
       /// \return Sliced DataObject.
       std::shared_ptr<DataObjectBase> slice(const std::vector<std::size_t>& rows) const final
       {
+        materialize();
         // Compute product of extra dimensions)
         std::size_t extraDims = 1;
         for (std::size_t i = 1; i < dims_.size(); ++i)
@@ -642,7 +1016,26 @@ namespace bufr {
 
         auto slicedDataObject = std::make_shared<DataObject<T>>();
 
-        slicedDataObject->setData(newData);
+        if (hasValidity_)
+        {
+          std::vector<uint64_t> newValidity(numWords(newData.size()), 0);
+          size_t newIdx = 0;
+          for (std::size_t i = 0; i < rows.size(); ++i)
+          {
+            for (std::size_t idx = rows[i] * extraDims; idx < (rows[i] + 1) * extraDims; ++idx)
+            {
+              if (testBit(validity_, idx)) setBit(newValidity, newIdx);
+              newIdx++;
+            }
+          }
+
+          slicedDataObject->setData(newData, newValidity);
+        }
+        else
+        {
+          slicedDataObject->setData(newData);
+        }
+
         slicedDataObject->setFieldName(fieldName_);
         slicedDataObject->setGroupByFieldName(groupByFieldName_);
         slicedDataObject->setDims(sliceDims);
@@ -652,10 +1045,151 @@ namespace bufr {
         return slicedDataObject;
       }
 
+      /// \brief Make a lightweight view of some of the rows of this object.
+      /// \param rows The indices of the rows to view.
+      /// \return View of the rows.
+      std::shared_ptr<DataObjectBase> view(const std::vector<std::size_t>& rows) const final
+      {
+        auto viewObject = std::make_shared<DataObject<T>>();
+        initView(*viewObject, rows);
+        return viewObject;
+      }
+
       friend class DataObjectBuilder;
 
     private:
-      std::vector<T> data_;
+      // Mutable so views can be materialised on first access.
+      mutable std::vector<T> data_;
+
+      /// \brief Optional packed validity bitmap (bit set means valid). When present it is used
+      ///        instead of comparing against the missing value.
+      mutable std::vector<uint64_t> validity_;
+      mutable bool hasValidity_ = false;
+
+      /// \brief Copy the viewed rows out of the parent object and release it.
+      void materializeView() const final
+      {
+        auto parent = std::static_pointer_cast<const DataObject<T>>(viewParent_);
+        auto sliced = std::static_pointer_cast<DataObject<T>>(parent->slice(viewRows_));
+
+        data_ = std::move(sliced->data_);
+        validity_ = std::move(sliced->validity_);
+        hasValidity_ = sliced->hasValidity_;
+
+        viewParent_.reset();
+        std::vector<std::size_t>().swap(viewRows_);
+      }
+
+      static size_t numWords(size_t numBits) { return (numBits + 63) / 64; }
+
+      static bool testBit(const std::vector<uint64_t>& bits, size_t idx)
+      {
+        return (bits[idx >> 6] >> (idx & 63)) & 1;
+      }
+
+      static void setBit(std::vector<uint64_t>& bits, size_t idx)
+      {
+        bits[idx >> 6] |= uint64_t(1) << (idx & 63);
+      }
+
+      /// \brief Compute a validity bitmap by comparing with the missing value.
+      std::vector<uint64_t> validityFromSentinel() const
+      {
+        std::vector<uint64_t> validity(numWords(data_.size()), 0);
+        for (size_t idx = 0; idx < data_.size(); ++idx)
+        {
+          if (data_[idx] != missingValue()) setBit(validity, idx);
+        }
+
+        return validity;
+      }
+
+      /// \brief Are there values marked missing by the bitmap that don't hold the missing value.
+      bool hasUnfilledMissing() const
+      {
+        if (!hasValidity_) return false;
+
+        for (size_t word = 0; word < validity_.size(); ++word)
+        {
+          const auto bits = validity_[word];
+          if (bits == ~uint64_t(0)) continue;
+
+          const size_t start = word * 64;
+          const size_t end = std::min(start + 64, data_.size());
+          for (size_t idx = start; idx < end; ++idx)
+          {
+            if (!((bits >> (idx - start)) & 1) && data_[idx] != missingValue()) return true;
+          }
+        }
+
+        return false;
+      }
+
+      /// \brief Get a copy of the data with the missing value wherever the bitmap is unset.
+      std::vector<T> dataWithMissingFilled() const
+      {
+        auto data = data_;
+        for (size_t idx = 0; idx < data.size(); ++idx)
+        {
+          if (!testBit(validity_, idx)) data[idx] = missingValue();
+        }
+
+        return data;
+      }
+
+      /// \brief Get one byte per element that is 1 for valid values.
+      std::vector<char> unpackValidity() const
+      {
+        std::vector<char> valid(data_.size(), 0);
+        for (size_t idx = 0; idx < data_.size(); ++idx)
+        {
+          valid[idx] = hasValidity_ ? testBit(validity_, idx) : data_[idx] != missingValue();
+        }
+
+        return valid;
+      }
+
+      /// \brief Replace every valid value x with func(x). Missing values are left untouched by
+      ///        selecting between the old and new value rather than branching, so the loops can be
+      ///        vectorised.
+      template<typename Func>
+      void applyAffine(Func&& func)
+      {
+        T* data = data_.data();
+
+        if (!hasValidity_)
+        {
+          const T missing = missingValue();
+          for (size_t idx = 0; idx < data_.size(); idx++)
+          {
+            const T value = data[idx];
+            data[idx] = value != missing ? func(value) : value;
+          }
+
+          return;
+        }
+
+        for (size_t word = 0; word < validity_.size(); ++word)
+        {
+          const auto bits = validity_[word];
+          const size_t start = word * 64;
+          const size_t end = std::min(start + 64, data_.size());
+
+          if (bits == 0) continue;
+
+          if (bits == ~uint64_t(0))
+          {
+            for (size_t idx = start; idx < end; ++idx) data[idx] = func(data[idx]);
+            continue;
+          }
+
+          for (size_t idx = start; idx < end; ++idx)
+          {
+            const T value = data[idx];
+            data[idx] = ((bits >> (idx - start)) & 1) ? func(value) : value;
+          }
+        }
+      }
   };
 
   template<>
@@ -668,13 +1202,20 @@ namespace bufr {
       /// \return copy
       std::shared_ptr<DataObjectBase> copy() const final
       {
+        std::lock_guard<std::mutex> lock(viewMutex_);
         auto copy = std::make_shared<DataObject<std::string>>();
         copy->data_ = data_;
+        copy->codes_ = codes_;
+        copy->dictionary_ = dictionary_;
+        copy->isDictionaryEncoded_ = isDictionaryEncoded_;
         copy->fieldName_ = fieldName_;
         copy->groupByFieldName_ = groupByFieldName_;
         copy->dims_ = dims_;
         copy->query_ = query_;
         copy->dimPaths_ = dimPaths_;
+        copy->viewParent_ = viewParent_;
+        copy->viewRows_ = viewRows_;
+        copy->viewPending_.store(viewParent_ != nullptr, std::memory_order_release);
         return copy;
       }
 
@@ -683,6 +1224,12 @@ namespace bufr {
         return "";
       }
 
+      /// \brief Get the code used for missing values in dictionary encoded data.
+      constexpr static int missingCode()
+      {
+        return std::numeric_limits<int>::max();
+      }
+
       /// \brief Print the data object to a output stream.
       void print(std::ostream& out) const final
       {
@@ -714,13 +1261,14 @@ namespace bufr {
       /// \return bool data.
       bool isMissing(const Location& loc) const final
       {
-        return get(loc) == "";
+        return isMissing(idxFromLoc(loc));
       }
 
       /// \brief Get the data at the index as an int.
       /// \return Int data.
       int getAsInt(size_t idx) const final
       {
+        materialize();
         throw eckit::BadParameter("Cannot convert string to int");
       }
 
@@ -735,13 +1283,20 @@ namespace bufr {
       /// \return String data.
       std::string getAsString(size_t idx) const final
       {
-        return data_[idx];
+        materialize();
+        return valueAt(idx);
       }
 
       /// \brief Is the element at the index the missing value.
       /// \return bool data.
       bool isMissing(size_t idx) const final
       {
+        materialize();
+        if (isDictionaryEncoded_)
+        {
+          return codes_.at(idx) == missingCode();
+        }
+
         return data_.at(idx) == "";
       }
 
@@ -750,7 +1305,8 @@ namespace bufr {
       /// \return The data at the given location.
       std::string get(const Location& loc) const
       {
-        return data_[idxFromLoc(loc)];
+        materialize();
+        return valueAt(idxFromLoc(loc));
       };
 
       /// \brief Multiply the stored values in this data object by a scalar (string version).
@@ -767,11 +1323,22 @@ namespace bufr {
         throw eckit::BadParameter("Trying to offset a string by a number");
       }
 
+      /// \brief Scale and offset the stored values in this data object (string version).
+      /// \param scale Scalar to multiply the data by.
+      /// \param offset Scalar to add to the data after scaling.
+      void scaleAndOffset(double scale, double offset) final
+      {
+        throw eckit::BadParameter("Trying to scale and offset a string by a number");
+      }
+
       /// \brief Set the data associated with this data object (string DataObject).
       /// \param data The raw data
       /// \param dataMissingValue The number that represents missing values within the raw data
       void setData( const Data& data) final
       {
+        dropView();
+        clearDictionary();
+
         data_ = std::vector<std::string>();
         if (data.isLongStr())
         {
@@ -806,160 +1373,172 @@ namespace bufr {
       /// \param data The raw data
       void setData(const std::vector<std::string>& data)
       {
+        dropView();
+        clearDictionary();
         data_ = data;
       }
 
-      /// \brief Write the data out using a writer.
-      /// \param writer The writer to use.
-      void write(std::shared_ptr<ObjectWriterBase> writer) final
+      /// \brief Set dictionary encoded data (codes that index into a list of unique values).
+      /// \param codes The index into the dictionary for each element (missingCode() if missing).
+      /// \param dictionary The unique string values.
+      void setData(const std::vector<int>& codes, const std::vector<std::string>& dictionary)
       {
-        if (auto writerPtr = std::dynamic_pointer_cast<ObjectWriter<std::string>>(writer))
+        for (const auto& code : codes)
         {
-          writerPtr->write(data_);
-        }
-        else
-        {
-          std::ostringstream str;
-          str << "Can not write data of type " << typeid(std::string).name() << " with writer of type ";
-          str << typeid(writer).name();
-          throw eckit::BadParameter(str.str());
+          if (code != missingCode() && (code < 0 || code >= static_cast<int>(dictionary.size())))
+          {
+            std::ostringstream str;
+            str << "Dictionary code " << code << " is out of range for field " << fieldName_;
+            throw eckit::BadParameter(str.str());
+          }
         }
+
+        dropView();
+        data_.clear();
+        data_.shrink_to_fit();
+        codes_ = codes;
+        dictionary_ = dictionary;
+        isDictionaryEncoded_ = true;
       }
 
-      /// \brief Do an MPI Gather operation and accumalate the data into the root process.
-      /// \param comm The MPI communicator to use.
-      void gather(const eckit::mpi::Comm& comm) final
+      /// \brief Convert the stored strings into dictionary encoded form (codes plus unique
+      ///        values). Useful for low cardinality fields like station identifiers.
+      void encodeDictionary()
       {
-        size_t numDims = dims_.size();
-        comm.reduce(numDims, numDims, eckit::mpi::Operation::MAX, 0);
+        materialize();
+        if (isDictionaryEncoded_) return;
 
-        // Ensure all ranks have the same number of dimensions
-        if (numDims != dims_.size())
+        std::unordered_map<std::string, int> lookup;
+        codes_.resize(data_.size());
+        dictionary_.clear();
+        for (size_t idx = 0; idx < data_.size(); ++idx)
         {
-          int missingDims = numDims - dims_.size();
-          for (int idx = 0; idx < missingDims; ++idx)
+          if (data_[idx].empty())
           {
-            dims_.insert(dims_.end() - 1, 1);
+            codes_[idx] = missingCode();
+            continue;
           }
-        }
-
-        std::vector<int> rcvDims = dims_;
-        comm.reduce(rcvDims[0], rcvDims[0], eckit::mpi::Operation::SUM, 0);
 
-        for (size_t i = 1; i < numDims; ++i)
-        {
-          comm.allReduce(rcvDims[i], rcvDims[i], eckit::mpi::Operation::MAX);
-        }
+          auto result = lookup.emplace(data_[idx], static_cast<int>(dictionary_.size()));
+          if (result.second)
+          {
+            dictionary_.push_back(data_[idx]);
+          }
 
-        size_t sendSize = dims_[0];
-        for (size_t idx = 1; idx < rcvDims.size(); idx++)
-        {
-          sendSize *= rcvDims[idx];
+          codes_[idx] = result.first->second;
         }
 
-        // Fix my send buffer if the global extra dimensions (not the first one) differ from my own
-        // (resize and fill with missing values where necessary). This will involve creating a send
-        // array and copying data into the correct indices.
+        data_.clear();
+        data_.shrink_to_fit();
+        isDictionaryEncoded_ = true;
+      }
 
-        // Do the extra dimensions from the different ranks match?
-        bool adjustDims = false;
-        for (size_t idx = 1; idx < rcvDims.size(); idx++)
-        {
-          adjustDims = (rcvDims[idx] != getDims()[idx]);
-        }
+      /// \brief Convert dictionary encoded data back into a plain list of strings.
+      void decodeDictionary()
+      {
+        materialize();
+        if (!isDictionaryEncoded_) return;
 
-        // Resize the dimensions to match the global dimensions
-        if (adjustDims)
-        {
-          std::vector<std::string> sendBuffer(sendSize, missingValue());
+        data_ = getRawData();
+        clearDictionary();
+      }
 
-          // Map the local data into the sendBuffer using the dimensions
-          for (size_t i = 0; i < data_.size(); ++i)
-          {
-            Location loc;
+      /// \brief Is the data stored as dictionary codes plus unique values.
+      bool isDictionaryEncoded() const
+      {
+        materialize();
+        return isDictionaryEncoded_;
+      }
 
-            // Compute the location coordinate in the old data
-            size_t idx = i;
-            for (size_t dimIdx = 0; dimIdx < dims_.size(); ++dimIdx)
-            {
-              loc.push_back(idx % dims_[dimIdx]);
-              idx /= dims_[dimIdx];
-            }
+      /// \brief Get the dictionary codes (only valid if isDictionaryEncoded).
+      const std::vector<int>& getCodes() const
+      {
+        materialize();
+        return codes_;
+      }
 
-            // Map that location into the new data (compute the new index)
-            idx = 0;
-            for (size_t dimIdx = 0; dimIdx < rcvDims.size(); ++dimIdx)
-            {
-              idx += loc[dimIdx] * rcvDims[dimIdx];
-            }
+      /// \brief Get the unique values the codes refer to (only valid if isDictionaryEncoded).
+      const std::vector<std::string>& getDictionary() const
+      {
+        materialize();
+        return dictionary_;
+      }
 
-            sendBuffer[idx] = data_[i];
+      /// \brief Write the data out using a writer.
+      /// \param writer The writer to use.
+      void write(std::shared_ptr<ObjectWriterBase> writer) final
+      {
+        materialize();
+        if (auto writerPtr = std::dynamic_pointer_cast<ObjectWriter<std::string>>(writer))
+        {
+          if (isDictionaryEncoded_)
+          {
+            writerPtr->write(getRawData());
+          }
+          else
+          {
+            writerPtr->write(data_);
           }
-
-          data_ = std::move(sendBuffer);
         }
-
-        size_t charsToSend = 0;
-        for (const auto& str : data_)
+        else
         {
-          charsToSend += str.size();
+          std::ostringstream str;
+          str << "Can not write data of type " << typeid(std::string).name();
+          str << " with writer of type ";
+          str << typeid(writer).name();
+          throw eckit::BadParameter(str.str());
         }
+      }
 
-        size_t charsToReceive = charsToSend;
-        comm.reduce(charsToReceive, charsToReceive, eckit::mpi::Operation::SUM, 0);
-
-        auto sizeArray = std::vector<int>(comm.size());
-        comm.allGather(static_cast<int>(charsToSend), sizeArray.begin(), sizeArray.end());
+      /// \brief Do an MPI Gather operation and accumalate the data into the root process.
+      /// \param comm The MPI communicator to use.
+      /// \param root The rank to gather the data into.
+      void gather(const eckit::mpi::Comm& comm, size_t root = 0) final
+      {
+        materialize();
+        // If any rank is dictionary encoded then the result should be as well.
+        int encoded = isDictionaryEncoded_ ? 1 : 0;
+        comm.allReduce(encoded, encoded, eckit::mpi::Operation::MAX);
 
-        std::vector<char> rcvBuffer(charsToReceive, 0);
-        auto rcvCounts = std::vector<int>(comm.size());
+        auto rcvDims = gatherDims(comm, root);
 
-        std::vector<int> displacement(comm.size(), 0);
-        for (size_t i = 1; i < comm.size(); i++)
+        if (encoded)
         {
-          displacement[i] =  displacement[i - 1] + sizeArray[i - 1];
+          encodeDictionary();
+          gatherDictionary(comm, rcvDims, root);
+          return;
         }
 
-        std::vector<char> charSendBuffer;
-        for (const auto& str : data_)
-        {
-          charSendBuffer.insert(charSendBuffer.end(), str.begin(), str.end());
-        }
+        // Fix my send buffer if the global extra dimensions (not the first one) differ from my own
+        // (resize and fill with missing values where necessary).
+        padToDims(data_, rcvDims, missingValue());
 
-        comm.gatherv(charSendBuffer, rcvBuffer, sizeArray, displacement, 0);
+        auto strs = gatherStrings(comm, data_, root);
 
-        std::vector<int> myStrSizes(data_.size());
-        for (size_t idx=0; idx < data_.size(); ++idx)
+        if (comm.rank() == root)
         {
-          myStrSizes[idx] = data_[idx].size();
+          dims_ = rcvDims;
+          data_ = std::move(strs);
         }
+      }
 
-        comm.allGather(static_cast<int>(myStrSizes.size()), sizeArray.begin(), sizeArray.end());
+      /// \brief Make the extra dimensions the same on all the ranks (see DataObjectBase).
+      /// \param comm The MPI communicator to use.
+      void alignDims(const eckit::mpi::Comm& comm) final
+      {
+        materialize();
+        auto globalDims = alignedDims(comm);
 
-        for (size_t i = 1; i < comm.size(); i++)
+        if (isDictionaryEncoded_)
         {
-          displacement[i] =  displacement[i - 1] + sizeArray[i - 1];
+          padToDims(codes_, globalDims, missingCode());
         }
-
-        size_t numStrs = data_.size();
-        comm.reduce(numStrs, numStrs, eckit::mpi::Operation::SUM, 0);
-        std::vector<int> strSizes(numStrs);
-        comm.gatherv(myStrSizes, strSizes, sizeArray, displacement, 0);
-
-        if (comm.rank() == 0)
+        else
         {
-          dims_ = rcvDims;
-
-          // write rcvBuffer back to data
-          data_.resize(numStrs);
-          size_t offset = 0;
-          for (size_t idx = 0; idx < numStrs; ++idx)
-          {
-            std::string str(rcvBuffer.begin() + offset, rcvBuffer.begin() + offset + strSizes[idx]);
-            data_[idx] = str;
-            offset += strSizes[idx];
-          }
+          padToDims(data_, globalDims, missingValue());
         }
+
+        dims_ = globalDims;
       }
 
       /// \brief Append the data from another DataObject to this one.
@@ -974,6 +1553,9 @@ namespace bufr {
           throw eckit::BadParameter(str.str());
         }
 
+        materialize();
+        other->materialize();
+
         dims_[0] += other->dims_[0];
         for (size_t i = 1; i < dims_.size(); ++i)
         {
@@ -984,7 +1566,60 @@ namespace bufr {
             throw eckit::BadParameter(str.str());
           }
         }
-        data_.insert(data_.end(), other->data_.begin(), other->data_.end());
+
+        if (!isDictionaryEncoded_ && !other->isDictionaryEncoded_)
+        {
+          data_.insert(data_.end(), other->data_.begin(), other->data_.end());
+        }
+        else if (!isDictionaryEncoded_)
+        {
+          auto otherData = other->getRawData();
+          data_.insert(data_.end(), otherData.begin(), otherData.end());
+        }
+        else
+        {
+          // Merge the other dictionary into ours and remap the incoming codes.
+          std::unordered_map<std::string, int> lookup;
+          for (size_t idx = 0; idx < dictionary_.size(); ++idx)
+          {
+            lookup.emplace(dictionary_[idx], static_cast<int>(idx));
+          }
+
+          auto addValue = [&lookup, this](const std::string& value) -> int
+          {
+            if (value.empty()) return missingCode();
+
+            auto result = lookup.emplace(value, static_cast<int>(dictionary_.size()));
+            if (result.second)
+            {
+              dictionary_.push_back(value);
+            }
+
+            return result.first->second;
+          };
+
+          codes_.reserve(codes_.size() + other->size());
+          if (other->isDictionaryEncoded_)
+          {
+            std::vector<int> remap(other->dictionary_.size());
+            for (size_t idx = 0; idx < other->dictionary_.size(); ++idx)
+            {
+              remap[idx] = addValue(other->dictionary_[idx]);
+            }
+
+            for (const auto& code : other->codes_)
+            {
+              codes_.push_back(code == missingCode() ? missingCode() : remap[code]);
+            }
+          }
+          else
+          {
+            for (const auto& value : other->data_)
+            {
+              codes_.push_back(addValue(value));
+            }
+          }
+        }
       }
 
       /// \brief Makes a new dimension scale using this data object as the source
@@ -993,19 +1628,21 @@ namespace bufr {
       std::shared_ptr<DimensionDataBase> createDimensionFromData(const std::string& name,
                                                                  std::size_t dimIdx) const final
       {
+        materialize();
         auto dimData = std::make_shared<DimensionData<std::string>>(name, getDims()[dimIdx]);
+        const auto data = getRawData();
 
-        std::copy(data_.begin(),
-                  data_.begin() + dimData->data.size(),
+        std::copy(data.begin(),
+                  data.begin() + dimData->data.size(),
                   dimData->data.begin());
 
         // Validate this data object (has values that repeat for each frame
-        for (size_t idx = 0; idx < data_.size(); idx += dimData->data.size())
+        for (size_t idx = 0; idx < data.size(); idx += dimData->data.size())
         {
-          if (!std::equal(data_.begin(),
-                          data_.begin() + dimData->data.size(),
-                          data_.begin() + idx,
-                          data_.begin() + idx + dimData->data.size()))
+          if (!std::equal(data.begin(),
+                          data.begin() + dimData->data.size(),
+                          data.begin() + idx,
+                          data.begin() + idx + dimData->data.size()))
           {
             std::stringstream errStr;
             errStr << "Dimension " << name << " has an invalid source field. ";
@@ -1022,6 +1659,7 @@ namespace bufr {
       /// \return Sliced DataObject.
       std::shared_ptr<DataObjectBase> slice(const std::vector<std::size_t>& rows) const final
       {
+        materialize();
         // Compute product of extra dimensions)
         std::size_t extraDims = 1;
         for (std::size_t i = 1; i < dims_.size(); ++i)
@@ -1029,22 +1667,50 @@ namespace bufr {
           extraDims *= dims_[i];
         }
 
+        auto slicedDataObject = std::make_shared<DataObject<std::string>>();
+
         // Make new DataObject with the rows we want
-        std::vector<std::string> newData;
-        newData.reserve(rows.size() * extraDims);
-        for (std::size_t i = 0; i < rows.size(); ++i)
+        if (isDictionaryEncoded_)
         {
-          newData.insert(newData.end(),
-                         data_.begin() + rows[i] * extraDims,
-                         data_.begin() + (rows[i] + 1) * extraDims);
+          // Only keep the dictionary values that the rows use (in the order they are first used)
+          std::vector<int> remap(dictionary_.size(), missingCode());
+          std::vector<std::string> newDictionary;
+          std::vector<int> newCodes;
+          newCodes.reserve(rows.size() * extraDims);
+          for (std::size_t i = 0; i < rows.size(); ++i)
+          {
+            for (std::size_t idx = rows[i] * extraDims; idx < (rows[i] + 1) * extraDims; ++idx)
+            {
+              const auto code = codes_[idx];
+              if (code != missingCode() && remap[code] == missingCode())
+              {
+                remap[code] = static_cast<int>(newDictionary.size());
+                newDictionary.push_back(dictionary_[code]);
+              }
+
+              newCodes.push_back(code == missingCode() ? missingCode() : remap[code]);
+            }
+          }
+
+          slicedDataObject->setData(newCodes, newDictionary);
+        }
+        else
+        {
+          std::vector<std::string> newData;
+          newData.reserve(rows.size() * extraDims);
+          for (std::size_t i = 0; i < rows.size(); ++i)
+          {
+            newData.insert(newData.end(),
+                           data_.begin() + rows[i] * extraDims,
+                           data_.begin() + (rows[i] + 1) * extraDims);
+          }
+
+          slicedDataObject->setData(newData);
         }
 
         auto sliceDims = dims_;
         sliceDims[0] = rows.size();
 
-        auto slicedDataObject = std::make_shared<DataObject<std::string>>();
-
-        slicedDataObject->setData(newData);
         slicedDataObject->setFieldName(fieldName_);
         slicedDataObject->setGroupByFieldName(groupByFieldName_);
         slicedDataObject->setDims(sliceDims);
@@ -1056,18 +1722,236 @@ namespace bufr {
 
       /// \brief Get the raw data associated with this data object.
       /// \return The raw data.
-      std::vector<std::string> getRawData() const { return data_; }
+      std::vector<std::string> getRawData() const
+      {
+        materialize();
+        if (!isDictionaryEncoded_)
+        {
+          return data_;
+        }
+
+        std::vector<std::string> data(codes_.size());
+        for (size_t idx = 0; idx < codes_.size(); ++idx)
+        {
+          if (codes_[idx] != missingCode())
+          {
+            data[idx] = dictionary_[codes_[idx]];
+          }
+        }
+
+        return data;
+      }
 
       /// \brief Get the size of the data object.
       /// \return The size of the data object.
       size_t size() const final
       {
-        return data_.size();
+        if (isView())
+        {
+          std::lock_guard<std::mutex> lock(viewMutex_);
+          if (viewParent_)
+          {
+            return viewParent_->size() / std::max<size_t>(viewParent_->getDims()[0], 1) *
+                   viewRows_.size();
+          }
+        }
+
+        return isDictionaryEncoded_ ? codes_.size() : data_.size();
+      }
+
+      /// \brief Make a lightweight view of some of the rows of this object.
+      /// \param rows The indices of the rows to view.
+      /// \return View of the rows.
+      std::shared_ptr<DataObjectBase> view(const std::vector<std::size_t>& rows) const final
+      {
+        auto viewObject = std::make_shared<DataObject<std::string>>();
+        initView(*viewObject, rows);
+        return viewObject;
       }
 
       friend class DataObjectBuilder;
 
     private:
-      std::vector<std::string> data_;
+      // Mutable so views can be materialised on first access.
+      mutable std::vector<std::string> data_;
+      mutable std::vector<int> codes_;
+      mutable std::vector<std::string> dictionary_;
+      mutable bool isDictionaryEncoded_ = false;
+
+      /// \brief Copy the viewed rows out of the parent object and release it.
+      void materializeView() const final
+      {
+        auto parent = std::static_pointer_cast<const DataObject<std::string>>(viewParent_);
+        auto sliced = std::static_pointer_cast<DataObject<std::string>>(parent->slice(viewRows_));
+
+        data_ = std::move(sliced->data_);
+        codes_ = std::move(sliced->codes_);
+        dictionary_ = std::move(sliced->dictionary_);
+        isDictionaryEncoded_ = sliced->isDictionaryEncoded_;
+
+        viewParent_.reset();
+        std::vector<std::size_t>().swap(viewRows_);
+      }
+
+      /// \brief Get the string value at the index for either storage format.
+      std::string valueAt(size_t idx) const
+      {
+        if (isDictionaryEncoded_)
+        {
+          const auto code = codes_[idx];
+          return code == missingCode() ? missingValue() : dictionary_[code];
+        }
+
+        return data_[idx];
+      }
+
+      /// \brief Drop any dictionary encoded data.
+      void clearDictionary()
+      {
+        codes_.clear();
+        dictionary_.clear();
+        isDictionaryEncoded_ = false;
+      }
+
+      /// \brief Gather a list of strings from all ranks onto the root process.
+      /// \return The concatenated list (only valid on the root process).
+      static std::vector<std::string> gatherStrings(const eckit::mpi::Comm& comm,
+                                                    const std::vector<std::string>& strs,
+                                                    size_t root = 0)
+      {
+        size_t charsToSend = 0;
+        for (const auto& str : strs)
+        {
+          charsToSend += str.size();
+        }
+
+        size_t charsToReceive = charsToSend;
+        comm.reduce(charsToReceive, charsToReceive, eckit::mpi::Operation::SUM, root);
+
+        auto sizeArray = std::vector<int>(comm.size());
+        comm.allGather(static_cast<int>(charsToSend), sizeArray.begin(), sizeArray.end());
+
+        std::vector<char> rcvBuffer(charsToReceive, 0);
+
+        std::vector<int> displacement(comm.size(), 0);
+        for (size_t i = 1; i < comm.size(); i++)
+        {
+          displacement[i] =  displacement[i - 1] + sizeArray[i - 1];
+        }
+
+        std::vector<char> charSendBuffer;
+        charSendBuffer.reserve(charsToSend);
+        for (const auto& str : strs)
+        {
+          charSendBuffer.insert(charSendBuffer.end(), str.begin(), str.end());
+        }
+
+        comm.gatherv(charSendBuffer, rcvBuffer, sizeArray, displacement, root);
+
+        std::vector<int> myStrSizes(strs.size());
+        for (size_t idx=0; idx < strs.size(); ++idx)
+        {
+          myStrSizes[idx] = strs[idx].size();
+        }
+
+        comm.allGather(static_cast<int>(myStrSizes.size()), sizeArray.begin(), sizeArray.end());
+
+        for (size_t i = 1; i < comm.size(); i++)
+        {
+          displacement[i] =  displacement[i - 1] + sizeArray[i - 1];
+        }
+
+        size_t numStrs = strs.size();
+        comm.reduce(numStrs, numStrs, eckit::mpi::Operation::SUM, root);
+        std::vector<int> strSizes(numStrs);
+        comm.gatherv(myStrSizes, strSizes, sizeArray, displacement, root);
+
+        std::vector<std::string> result;
+        if (comm.rank() == root)
+        {
+          // write rcvBuffer back to data
+          result.resize(numStrs);
+          size_t offset = 0;
+          for (size_t idx = 0; idx < numStrs; ++idx)
+          {
+            result[idx] = std::string(rcvBuffer.begin() + offset,
+                                      rcvBuffer.begin() + offset + strSizes[idx]);
+            offset += strSizes[idx];
+          }
+        }
+
+        return result;
+      }
+
+      /// \brief Gather dictionary encoded data. Each rank's codes are offset into the
+      ///        concatenated dictionaries, which are then de-duplicated on the root process.
+      void gatherDictionary(const eckit::mpi::Comm& comm,
+                            const std::vector<int>& rcvDims,
+                            size_t root = 0)
+      {
+        padToDims(codes_, rcvDims, missingCode());
+
+        auto dictSizes = std::vector<int>(comm.size());
+        comm.allGather(static_cast<int>(dictionary_.size()), dictSizes.begin(), dictSizes.end());
+
+        int dictOffset = 0;
+        for (size_t i = 0; i < comm.rank(); i++)
+        {
+          dictOffset += dictSizes[i];
+        }
+
+        std::vector<int> sendCodes(codes_.size());
+        for (size_t idx = 0; idx < codes_.size(); ++idx)
+        {
+          sendCodes[idx] = codes_[idx] == missingCode() ? missingCode() : codes_[idx] + dictOffset;
+        }
+
+        size_t rcvSize = 1;
+        for (size_t idx = 0; idx < rcvDims.size(); idx++)
+        {
+          rcvSize *= rcvDims[idx];
+        }
+
+        auto sizeArray = std::vector<int>(comm.size());
+        comm.allGather(static_cast<int>(sendCodes.size()), sizeArray.begin(), sizeArray.end());
+
+        std::vector<int> displacement(comm.size(), 0);
+        for (size_t i = 1; i < comm.size(); i++)
+        {
+          displacement[i] =  displacement[i - 1] + sizeArray[i - 1];
+        }
+
+        std::vector<int> rcvCodes(rcvSize, missingCode());
+        comm.gatherv(sendCodes, rcvCodes, sizeArray, displacement, root);
+
+        auto allValues = gatherStrings(comm, dictionary_, root);
+
+        if (comm.rank() == root)
+        {
+          // Different ranks may have found the same values, so remove the duplicates.
+          std::unordered_map<std::string, int> lookup;
+          std::vector<std::string> dictionary;
+          std::vector<int> remap(allValues.size());
+          for (size_t idx = 0; idx < allValues.size(); ++idx)
+          {
+            auto result = lookup.emplace(allValues[idx], static_cast<int>(dictionary.size()));
+            if (result.second)
+            {
+              dictionary.push_back(allValues[idx]);
+            }
+
+            remap[idx] = result.first->second;
+          }
+
+          for (auto& code : rcvCodes)
+          {
+            if (code != missingCode()) code = remap[code];
+          }
+
+          dims_ = rcvDims;
+          codes_ = std::move(rcvCodes);
+          dictionary_ = std::move(dictionary);
+        }
+      }
   };
 }  // namespace bufr
@@ -0,0 +1,69 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bufr {
+    /// \brief Number of days from 1970-01-01 to the given (proleptic Gregorian) date. Months
+    ///        outside 1-12 and days outside the month roll over into the neighbouring ones (like
+    ///        timegm). Uses only integer arithmetic, so unlike mktime/timegm it doesn't depend on
+    ///        the time zone or take any locks.
+    /// \param year The year (ex: 2024)
+    /// \param month The month (1-12)
+    /// \param day The day of the month (1-31)
+    constexpr int64_t daysFromCivil(int64_t year, int64_t month, int64_t day)
+    {
+        // Move months outside 1-12 into the year
+        const int64_t monthIdx = month - 1;
+        const int64_t yearShift = (monthIdx >= 0 ? monthIdx : monthIdx - 11) / 12;
+        year += yearShift;
+        month = monthIdx - yearShift * 12 + 1;
+
+        // Count from March 1st so the leap day is the last day of the (shifted) year
+        year -= month <= 2;
+        const int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const int64_t yearOfEra = year - era * 400;
+        const int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    /// \brief Number of seconds from 1970-01-01T00:00:00Z to the given UTC date and time.
+    constexpr int64_t secondsSinceEpoch(int64_t year,
+                                        int64_t month,
+                                        int64_t day,
+                                        int64_t hour,
+                                        int64_t minute,
+                                        int64_t second)
+    {
+        return daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    }
+
+    /// \brief Compute secondsSinceEpoch for whole columns of date and time values.
+    /// \param size The number of values in each column.
+    /// \param year, month, day, hour The date and time columns.
+    /// \param minute, second _optional_ Minute and second columns (nullptr means 0).
+    /// \param seconds Output column of seconds since the epoch.
+    inline void secondsSinceEpoch(size_t size,
+                                  const int* year,
+                                  const int* month,
+                                  const int* day,
+                                  const int* hour,
+                                  const int* minute,
+                                  const int* second,
+                                  int64_t* seconds)
+    {
+        for (size_t idx = 0; idx < size; ++idx)
+        {
+            seconds[idx] = secondsSinceEpoch(year[idx],
+                                             month[idx],
+                                             day[idx],
+                                             hour[idx],
+                                             minute ? minute[idx] : 0,
+                                             second ? second[idx] : 0);
+        }
+    }
+}  // namespace bufr
@@ -1,9 +1,12 @@
 // (C) Copyright 2020 NOAA/NWS/NCEP/EMC
 #pragma once
 
+#include <vector>
+
 #include "eckit/config/LocalConfiguration.h"
 
 #include "bufr/BufrTypes.h"
+#include "bufr/QuerySet.h"
 
 namespace bufr {
     /// \brief Base class for all the supported filters.
@@ -14,9 +17,51 @@ namespace bufr {
         /// \param conf The configuration for this filter
         explicit Filter(const eckit::LocalConfiguration& conf) : conf_(conf) {}
 
+        virtual ~Filter() = default;
+
+        /// \brief Clear the entries of the row mask for the rows this filter rejects. Lets
+        ///        several filters be combined before any of the data is sliced.
+        /// \param dataMap The data to filter.
+        /// \param rowMask One entry per row (non-zero means keep the row).
+        virtual void updateMask(const BufrDataMap& dataMap, std::vector<char>& rowMask) const = 0;
+
+        /// \brief Add predicates to the QuerySet so BUFR subsets this filter would reject are
+        ///        dropped while the file is read. Only valid when each row of the exported data
+        ///        is one subset (no group by variable). The default adds nothing.
+        /// \param querySet The QuerySet to add the predicates to.
+        virtual void addPredicates(QuerySet& querySet) const {}
+
         /// \brief Apply the filter to the data
         /// \param dataMap Map to modify by filtering out relevant data.
-        virtual void apply(BufrDataMap& dataMap) = 0;
+        void apply(BufrDataMap& dataMap) const
+        {
+            if (dataMap.empty()) return;
+
+            std::vector<char> rowMask(dataMap.begin()->second->getDims()[0], 1);
+            updateMask(dataMap, rowMask);
+            applyMask(dataMap, rowMask);
+        }
+
+        /// \brief Remove the rows that are not set in the row mask from every field (one slice
+        ///        per field).
+        /// \param dataMap Map to modify by filtering out relevant data.
+        /// \param rowMask One entry per row (non-zero means keep the row).
+        static void applyMask(BufrDataMap& dataMap, const std::vector<char>& rowMask)
+        {
+            std::vector<size_t> validRows;
+            validRows.reserve(rowMask.size());
+            for (size_t rowIdx = 0; rowIdx < rowMask.size(); ++rowIdx)
+            {
+                if (rowMask[rowIdx]) validRows.push_back(rowIdx);
+            }
+
+            if (validRows.size() == rowMask.size()) return;
+
+            for (auto& dataPair : dataMap)
+            {
+                dataPair.second = dataPair.second->slice(validRows);
+            }
+        }
 
      protected:
         eckit::LocalConfiguration conf_;
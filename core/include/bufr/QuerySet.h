@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <functional>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <set>
 #include <string>
@@ -18,8 +20,14 @@
 
 namespace bufr {
   class QuerySetImpl;
+  struct Data;
   typedef std::set<std::string> Subsets;
 
+  /// \brief Test run on all the values a query collected from one BUFR subset. Subsets for
+  ///        which it returns false are dropped as the file is read.
+  typedef std::function<bool(const Data& data)> SubsetPredicate;
+  typedef std::vector<std::pair<std::string, SubsetPredicate>> SubsetPredicates;
+
   /// \brief Manages a collection of queries.
   class QuerySet
   {
@@ -51,6 +59,15 @@ namespace bufr {
 
     std::vector<Query> queriesFor(const std::string& name) const;
 
+    /// \brief Only keep subsets whose values for the named query pass the predicate. Queries
+    ///        that use filters (ex: {1,2}) or that don't apply to a subset are not tested.
+    /// \param[in] name The name of the query the predicate tests.
+    /// \param[in] predicate The predicate.
+    void addPredicate(const std::string& name, const SubsetPredicate& predicate);
+
+    /// \brief Returns the predicates subsets must pass.
+    SubsetPredicates predicates() const;
+
     friend class QueryRunner;
 
    private:
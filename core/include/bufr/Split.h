@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -9,6 +10,7 @@
 #include "eckit/config/LocalConfiguration.h"
 
 #include "bufr/BufrTypes.h"
+#include "bufr/QuerySet.h"
 
 namespace bufr {
     /// \brief Base class for all Split objects that split data into sub-parts
@@ -31,6 +33,15 @@ namespace bufr {
         /// \result map of split data where the category is the key
         virtual std::unordered_map<std::string, BufrDataMap> split(const BufrDataMap& dataMap) = 0;
 
+        /// \brief Add predicates to the QuerySet so BUFR subsets that don't belong to one of the
+        ///        given categories are dropped while the file is read. Only valid when each row
+        ///        of the exported data is one subset (no group by variable). The default adds
+        ///        nothing.
+        /// \param querySet The QuerySet to add the predicates to.
+        /// \param categories Names of the categories to keep.
+        virtual void addPredicates(QuerySet& querySet, const std::set<std::string>& categories) const
+        {}
+
         /// \brief Get the split name
         inline std::string getName() const { return name_; }
 
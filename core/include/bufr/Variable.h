@@ -3,10 +3,14 @@
 #pragma once
 
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include "eckit/exception/Exceptions.h"
+
 #include "BufrTypes.h"
+#include "Column.h"
 #include "DataObject.h"
 
 namespace bufr {
@@ -46,6 +50,9 @@ namespace bufr {
         /// \brief Get Export Name
         inline std::string getExportName() const { return exportName_; }
 
+        /// \brief Does exporting change the queried values (ex: scales or offsets them)
+        virtual bool hasTransforms() const { return false; }
+
      protected:
         /// \brief The for field of interest
         const std::string groupByField_;
@@ -59,6 +66,25 @@ namespace bufr {
         /// \brief Make a map of name and queries
         virtual QueryList makeQueryList() const = 0;
 
+        /// \brief Get the values of a field as a typed column (looked up and resolved once, so
+        ///        derived variables can loop over plain arrays).
+        /// \param map The previously parsed data.
+        /// \param name The name of the field.
+        template <typename T>
+        Column<T> column(const BufrDataMap& map, const std::string& name) const
+        {
+            auto objIt = map.find(name);
+            if (objIt == map.end())
+            {
+                std::ostringstream errStr;
+                errStr << "Query " << name << " could not be found during export of ";
+                errStr << exportName_ << ".";
+                throw eckit::BadParameter(errStr.str());
+            }
+
+            return Column<T>(objIt->second);
+        }
+
      private:
         /// \brief Name used to export this variable
         std::string exportName_;
@@ -38,6 +38,10 @@ namespace encoders {
         std::shared_ptr<Range> range;  // Optional
         std::vector<size_t> chunks;  // Optional
         int compressionLevel;  // Optional
+        std::string compressor = "deflate";  // Optional (deflate, zstd or blosc)
+        std::string quantize;  // Optional (bitgroom, granularbr or bitround)
+        int significantDigits = 0;  // Optional (significant bits for bitround)
+        bool dictionary = false;  // Optional
     };
 
     struct GlobalWriterBase
@@ -103,11 +107,35 @@ namespace encoders {
         void py_addVariable(const std::string& name,
                          const std::string& source,
                          const std::string& unit,
-                         const std::string& longName = "");
+                         const std::string& longName = "",
+                         bool dictionary = false);
 
         /// \brief Add Globals defenition
         void addGlobal(const std::shared_ptr<GlobalDescriptionBase>& global);
 
+        // Setters
+        /// \brief Set the target size (bytes) of automatically sized chunks (0 means chunks span
+        ///        whole dimensions)
+        inline void setChunkBytes(size_t chunkBytes) { chunkBytes_ = chunkBytes; }
+
+        /// \brief Set the compression of a variable
+        /// \param name The name of the variable
+        /// \param compressor deflate, zstd or blosc
+        /// \param compressionLevel 0-9 (0-22 for zstd), 0 turns compression off
+        /// \param quantize Optional bitgroom, granularbr or bitround quantization
+        /// \param significantDigits Significant digits (bits for bitround) kept by quantize
+        void setCompression(const std::string& name,
+                            const std::string& compressor,
+                            int compressionLevel,
+                            const std::string& quantize = "",
+                            int significantDigits = 0);
+
+        /// \brief Set whether compressed variables have their chunks compressed in parallel
+        inline void setParallelCompression(bool parallelCompression)
+        {
+            parallelCompression_ = parallelCompression;
+        }
+
         // Getters
         /// \brief Get the descriptions for the dimensions
         inline DimDescriptions getDims() const { return dimensions_; }
@@ -121,10 +149,23 @@ namespace encoders {
         /// \brief Get the output path template
         inline std::string getOutputPathTemplate() const { return outputPathTemplate_; }
 
+        /// \brief Get the target size (bytes) of automatically sized chunks (0 means chunks span
+        ///        whole dimensions)
+        inline size_t getChunkBytes() const { return chunkBytes_; }
+
+        /// \brief Get whether compressed variables have their chunks compressed in parallel
+        inline bool getParallelCompression() const { return parallelCompression_; }
+
      private:
         /// \brief The template to use output file to create
         std::string outputPathTemplate_;
 
+        /// \brief Target size (bytes) of automatically sized chunks
+        size_t chunkBytes_ = 1024 * 1024;
+
+        /// \brief Compress the chunks of compressed variables in parallel
+        bool parallelCompression_ = false;
+
         /// \brief Collection of defined dimensions
         DimDescriptions dimensions_;
 
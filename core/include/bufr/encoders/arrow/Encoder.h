@@ -0,0 +1,88 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+
+#include "bufr/DataContainer.h"
+#include "bufr/encoders/Description.h"
+
+
+namespace bufr {
+namespace encoders {
+namespace arrow {
+    /// \brief Uses encoders::Description and parsed data to create Arrow IPC data (one table per
+    ///        category). Every variable is a column named after the variable. Variables with
+    ///        more than one dimension are (nested) fixed size list columns, missing values are
+    ///        nulls, the globals are the schema metadata and the units and long names are the
+    ///        field metadata. The numeric data is written straight from the DataContainer, the
+    ///        strings are copied into the Arrow layout first. Only little endian machines are
+    ///        supported (the data is written in the machine's byte order).
+    class Encoder
+    {
+    public:
+        /// \brief The Arrow IPC formats.
+        enum class Format
+        {
+            File,  // Random access file format (Feather v2, .arrow)
+            Stream  // Streaming format (.arrows)
+        };
+
+        explicit Encoder(const std::string &yamlPath);
+
+        explicit Encoder(const Description &description);
+
+        explicit Encoder(const eckit::Configuration &conf);
+
+        /// \brief Encode the data into an Arrow IPC file for each category.
+        /// \param data The data container to use
+        /// \param path Path of the files. Sections labeled {__key__} are replaced with the
+        ///        category for that key (ex: "atms_{splits/satId}.arrow").
+        /// \param format The IPC format to write
+        /// \return The path of the file of each category.
+        std::map<SubCategory, std::string>
+            encode(const std::shared_ptr<DataContainer> &data,
+                   const std::string &path,
+                   Format format = Format::File);
+
+        /// \brief Encode the data into Arrow IPC bytes for each category (every buffer is
+        ///        copied into the returned bytes).
+        /// \param data The data container to use
+        /// \param format The IPC format to write
+        /// \return The Arrow IPC data of each category.
+        std::map<SubCategory, std::vector<uint8_t>>
+            encodeToBytes(const std::shared_ptr<DataContainer> &data,
+                          Format format = Format::Stream);
+
+    private:
+        /// \brief The description
+        const Description description_;
+
+        /// \brief Encode the data of one category.
+        /// \param data The data container to use
+        /// \param category The category to encode
+        /// \param isFile Write the file format instead of the stream format
+        /// \param sink Receives the bytes
+        void encodeCategory(const std::shared_ptr<DataContainer> &data,
+                            const SubCategory &category,
+                            bool isFile,
+                            const std::function<void(const void*, size_t)> &sink) const;
+
+        /// \brief Replace the {__key__} sections of the path with the categories.
+        /// \param path Template path
+        /// \param data The data container (has the category keys)
+        /// \param category The category to use
+        std::string makePath(const std::string &path,
+                             const std::shared_ptr<DataContainer> &data,
+                             const SubCategory &category) const;
+    };
+}  // namespace arrow
+}  // namespace encoders
+}  // namespace bufr
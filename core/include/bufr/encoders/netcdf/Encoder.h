@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "eckit/config/LocalConfiguration.h"
+#include "eckit/mpi/Comm.h"
 #include <netcdf>
 
 #include "bufr/DataContainer.h"
@@ -20,16 +23,40 @@ namespace netcdf {
     class Encoder
     {
     public:
+        /// \brief Bytes of a NetCDF file image. The memory is the one NetCDF made the image in
+        ///        (not a copy), it is released with free when the last reference goes away.
+        struct FileImage
+        {
+            std::shared_ptr<uint8_t> data;
+            size_t size = 0;
+        };
+
         struct Backend
         {
             bool isMemoryFile;
             std::string path;
 
-            Backend() : isMemoryFile(true), path("") {};
+            /// \brief Write every category as a group (named after the category values joined
+            ///        by "_") of the one file at path, instead of making a file per category.
+            bool categoriesAsGroups;
 
-            Backend(bool isInMemory, const std::string &backendPath) :
+            /// \brief Make the in-memory files (isMemoryFile) so that their file image can be
+            ///        taken when they are closed (see encodeToBytes).
+            bool isMemoryImage;
+
+            Backend() :
+                isMemoryFile(true),
+                path(""),
+                categoriesAsGroups(false),
+                isMemoryImage(false) {};
+
+            Backend(bool isInMemory,
+                    const std::string &backendPath,
+                    bool asGroups = false) :
                 isMemoryFile(isInMemory),
-                path(backendPath) {};
+                path(backendPath),
+                categoriesAsGroups(asGroups),
+                isMemoryImage(false) {};
         };
 
         explicit Encoder(const std::string &yamlPath);
@@ -40,18 +67,49 @@ namespace netcdf {
 
         /// \brief Encode the data into an netcdf NcFile object
         /// \param data The data container to use
-        /// \param append Add data to existing file?
+        /// \param append Add the data to the end of the (unlimited) Location dimension of existing
+        ///        files. Files that don't exist yet are created with an unlimited Location
+        ///        dimension so later data can be appended to them. Only for files on disk.
         std::map<SubCategory, std::shared_ptr<nc::NcFile>>
             encode(const std::shared_ptr<DataContainer> &data,
                    const Backend &backend = Backend(),
                    bool append = false);
 
+        /// \brief Encode the data of all the MPI ranks into one NetCDF-4 file per category that
+        ///        the ranks write together (parallel NetCDF-4 with MPI-IO). Every rank writes its
+        ///        own rows after the rows of the lower ranks, so no rank needs all the data.
+        ///        Collective: every rank must call it, with the same categories. String
+        ///        variables are written by rank 0 (HDF5 can't write them in parallel).
+        /// \param data The data container (with this rank's rows) to use
+        /// \param backend Where to write the files (must be on disk)
+        /// \param comm The MPI communicator of the ranks
+        /// \return The finished files (open for reading)
+        std::map<SubCategory, std::shared_ptr<nc::NcFile>>
+            encode(const std::shared_ptr<DataContainer> &data,
+                   const Backend &backend,
+                   const eckit::mpi::Comm &comm);
+
+        /// \brief Encode the data into in-memory NetCDF files and get their bytes (the same
+        ///        bytes the files would have on disk).
+        /// \param data The data container to use
+        /// \return The NetCDF file image of each category.
+        std::map<SubCategory, FileImage>
+            encodeToBytes(const std::shared_ptr<DataContainer> &data);
+
     private:
         typedef std::map<std::vector<Query>, DimensionDescription> NamedPathDims;
 
         /// \brief The description
         const Description description_;
 
+        /// \brief Encode the data (see encode). The files are written in parallel when there
+        ///        is a comm.
+        std::map<SubCategory, std::shared_ptr<nc::NcFile>>
+            encodeFiles(const std::shared_ptr<DataContainer> &data,
+                        const Backend &backend,
+                        bool append,
+                        const eckit::mpi::Comm *comm);
+
         /// \brief Create a string from a template string.
         /// \param prototype A template string ex: "my {dogType} barks". Sections labeled {__key__}
         ///        are treated as keys into the dictionary that defines their replacment values.
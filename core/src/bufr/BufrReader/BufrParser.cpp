@@ -5,6 +5,7 @@
 #include <chrono>  // NOLINT
 #include <iostream>
 #include <ostream>
+#include <set>
 
 #include <unistd.h>
 
@@ -13,6 +14,7 @@
 #include "bufr/QuerySet.h"
 #include "bufr/ResultSet.h"
 #include "bufr/Export.h"
+#include "bufr/Filter.h"
 #include "bufr/Split.h"
 #include "eckit/exception/Exceptions.h"
 #include "../Log.h"
@@ -53,19 +55,12 @@ namespace bufr {
         file_.close();
     }
 
-    std::shared_ptr<DataContainer> BufrParser::parse(const size_t maxMsgsToParse)
+    std::shared_ptr<DataContainer> BufrParser::parse(const size_t maxMsgsToParse,
+                                                     const std::vector<SubCategory>& categories)
     {
         auto startTime = std::chrono::steady_clock::now();
 
-        auto querySet = QuerySet(description_.getExport().getSubsets());
-
-        for (const auto &var : description_.getExport().getVariables())
-        {
-            for (const auto &queryPair : var->getQueryList())
-            {
-                querySet.add(queryPair.name, queryPair.query);
-            }
-        }
+        auto querySet = makeQuerySet(categories);
 
         log::info() << "Executing Queries" << std::endl;
         const auto resultSet = file_.execute(querySet, maxMsgsToParse);
@@ -82,7 +77,7 @@ namespace bufr {
         }
 
         log::info()  << "Exporting Data" << std::endl;
-        auto exportedData = exportData(srcData);
+        auto exportedData = exportData(srcData, categories);
 
         auto timeElapsed = std::chrono::steady_clock::now() - startTime;
         auto timeElapsedDuration = std::chrono::duration_cast<std::chrono::milliseconds>
@@ -94,17 +89,11 @@ namespace bufr {
         return exportedData;
     }
 
-    std::shared_ptr<DataContainer> BufrParser::parse(const eckit::mpi::Comm& comm)
+    std::shared_ptr<DataContainer> BufrParser::parse(const eckit::mpi::Comm& comm,
+                                                     const std::vector<SubCategory>& categories)
     {
       // Make the QuerySet
-      auto querySet = QuerySet(description_.getExport().getSubsets());
-      for (const auto &var : description_.getExport().getVariables())
-      {
-        for (const auto &queryPair : var->getQueryList())
-        {
-          querySet.add(queryPair.name, queryPair.query);
-        }
-      }
+      auto querySet = makeQuerySet(categories);
 
       auto msgsInFile = file_.size(querySet);
 
@@ -145,7 +134,7 @@ namespace bufr {
       }
 
       log::info() << "MPI task: " << comm.rank() << " Exporting Data" << std::endl;
-      auto exportedData = exportData(srcData);
+      auto exportedData = exportData(srcData, categories);
 
       auto timeElapsed = std::chrono::steady_clock::now() - startTime;
       auto timeElapsedDuration = std::chrono::duration_cast<std::chrono::milliseconds>
@@ -157,34 +146,143 @@ namespace bufr {
       return exportedData;
     }
 
-    std::shared_ptr<DataContainer> BufrParser::exportData(const BufrDataMap &srcData) {
+    QuerySet BufrParser::makeQuerySet(const std::vector<SubCategory>& categories) const
+    {
+        const auto exportDescription = description_.getExport();
+
+        auto querySet = QuerySet(exportDescription.getSubsets());
+
+        bool isGrouped = false;
+        std::set<std::string> rawNames;
+        for (const auto &var : exportDescription.getVariables())
+        {
+            for (const auto &queryPair : var->getQueryList())
+            {
+                querySet.add(queryPair.name, queryPair.query);
+                isGrouped = isGrouped || !queryPair.groupByField.empty();
+
+                if (!var->hasTransforms() && queryPair.type.empty())
+                {
+                    rawNames.insert(queryPair.name);
+                }
+            }
+        }
+
+        // When every exported row is a subset the filters can reject whole subsets while the file
+        // is read, so data that would be filtered out later is never collected.
+        if (!isGrouped)
+        {
+            // The predicates test the BUFR values as they are, so they are only used for
+            // variables whose values aren't transformed or converted to another type.
+            auto candidates = QuerySet(exportDescription.getSubsets());
+            for (const auto &filter : exportDescription.getFilters())
+            {
+                filter->addPredicates(candidates);
+            }
+
+            // Likewise subsets that don't belong to a requested category can be skipped.
+            const auto names = splitNames(categories);
+            const auto splits = exportDescription.getSplits();
+            for (size_t splitIdx = 0; splitIdx < names.size(); ++splitIdx)
+            {
+                splits[splitIdx]->addPredicates(candidates, names[splitIdx]);
+            }
+
+            for (const auto &predicate : candidates.predicates())
+            {
+                if (rawNames.find(predicate.first) != rawNames.end())
+                {
+                    querySet.addPredicate(predicate.first, predicate.second);
+                }
+            }
+        }
+
+        return querySet;
+    }
+
+    std::vector<std::set<std::string>> BufrParser::splitNames(
+        const std::vector<SubCategory>& categories) const
+    {
+        std::vector<std::set<std::string>> names;
+        if (categories.empty()) return names;
+
+        const auto numSplits = description_.getExport().getSplits().size();
+        names.resize(numSplits);
+        for (const auto& category : categories)
+        {
+            if (category.size() != numSplits)
+            {
+                std::ostringstream errStr;
+                errStr << "Requested category has " << category.size() << " names but there ";
+                errStr << "are " << numSplits << " splits.";
+                throw eckit::BadParameter(errStr.str());
+            }
+
+            for (size_t splitIdx = 0; splitIdx < numSplits; ++splitIdx)
+            {
+                names[splitIdx].insert(category[splitIdx]);
+            }
+        }
+
+        return names;
+    }
+
+    std::shared_ptr<DataContainer> BufrParser::exportData(
+                                                const BufrDataMap &srcData,
+                                                const std::vector<SubCategory>& categories)
+    {
         auto exportDescription = description_.getExport();
 
         auto filters = exportDescription.getFilters();
         auto splits = exportDescription.getSplits();
         auto vars = exportDescription.getVariables();
 
-        // Filter
+        // Filter (every filter updates one row mask so the data is only sliced once)
         BufrDataMap dataCopy = srcData;  // make mutable copy
-        for (const auto &filter : filters)
+        if (!filters.empty() && !dataCopy.empty())
         {
-            filter->apply(dataCopy);
+            std::vector<char> rowMask(dataCopy.begin()->second->getDims()[0], 1);
+            for (const auto &filter : filters)
+            {
+                filter->updateMask(dataCopy, rowMask);
+            }
+
+            Filter::applyMask(dataCopy, rowMask);
         }
 
-        // Split
+        // Split (only keeping the requested categories if there are any)
+        const auto names = splitNames(categories);
+        const auto isRequested = [&names](size_t splitIdx, const std::string& name)
+        {
+            return names.empty() || names[splitIdx].find(name) != names[splitIdx].end();
+        };
+
         CategoryMap catMap;
-        for (const auto &split : splits)
+        for (size_t splitIdx = 0; splitIdx < splits.size(); ++splitIdx)
         {
             std::ostringstream catName;
-            catName << "splits/" << split->getName();
-            catMap.insert({catName.str(), split->subCategories(dataCopy)});
+            catName << "splits/" << splits[splitIdx]->getName();
+
+            SubCategory subCategories;
+            for (const auto& name : splits[splitIdx]->subCategories(dataCopy))
+            {
+                if (isRequested(splitIdx, name)) subCategories.push_back(name);
+            }
+
+            catMap.insert({catName.str(), subCategories});
         }
 
         BufrParser::CatDataMap splitDataMaps;
         splitDataMaps.insert({std::vector<std::string>(), dataCopy});
-        for (const auto &split : splits)
+        for (size_t splitIdx = 0; splitIdx < splits.size(); ++splitIdx)
         {
-            splitDataMaps = splitData(splitDataMaps, *split);
+            splitDataMaps = splitData(splitDataMaps, *splits[splitIdx]);
+
+            for (auto it = splitDataMaps.begin(); it != splitDataMaps.end();)
+            {
+                if (isRequested(splitIdx, it->first.back())) ++it;
+                else it = splitDataMaps.erase(it);
+            }
         }
 
         // Export
@@ -8,6 +8,7 @@
 #include "eckit/exception/Exceptions.h"
 
 #include "Filters/BoundingFilter.h"
+#include "Filters/InListFilter.h"
 #include "Splits/CategorySplit.h"
 #include "Variables/QueryVariable.h"
 #include "Variables/DatetimeVariable.h"
@@ -18,6 +19,8 @@
 #include "Variables/TimeoffsetVariable.h"
 #include "Variables/SensorScanAngleVariable.h"
 #include "Variables/SensorScanPositionVariable.h"
+#include "Variables/ExpressionVariable.h"
+#include "Variables/ReduceVariable.h"
 #include "../../ObjectFactory.h"
 
 
@@ -41,6 +44,8 @@ namespace
             const char* AircraftAltitude = "aircraftAltitude";
             const char* SensorScanAngle = "sensorScanAngle";
             const char* SensorScanPosition = "sensorScanPosition";
+            const char* Expression = "expression";
+            const char* Reduce = "reduce";
             const char* Query = "query";
         }  // namespace Variable
 
@@ -52,6 +57,7 @@ namespace
         namespace Filter
         {
             const char* Bounding = "bounding";
+            const char* InList = "inList";
         }
     }  // namespace ConfKeys
 }  // namespace
@@ -133,6 +139,8 @@ namespace bufr {
             (ConfKeys::Variable::SensorScanAngle);
         variableFactory.registerObject<SensorScanPositionVariable>
             (ConfKeys::Variable::SensorScanPosition);
+        variableFactory.registerObject<ExpressionVariable>(ConfKeys::Variable::Expression);
+        variableFactory.registerObject<ReduceVariable>(ConfKeys::Variable::Reduce);
 
         if (conf.keys().size() == 0)
         {
@@ -198,6 +206,7 @@ namespace bufr {
 
         FilterFactory filterFactory;
         filterFactory.registerObject<BoundingFilter>(ConfKeys::Filter::Bounding);
+        filterFactory.registerObject<InListFilter>(ConfKeys::Filter::InList);
 
         auto subConfs = conf.getSubConfigurations();
         if (subConfs.size() == 0)
@@ -2,9 +2,9 @@
 
 #include "BoundingFilter.h"
 
+#include <limits>
 #include <ostream>
 
-#include "Eigen/Dense"
 #include "eckit/exception/Exceptions.h"
 
 namespace
@@ -19,8 +19,6 @@ namespace
 
 
 namespace bufr {
-    typedef Eigen::Array<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> EigArray;
-
     BoundingFilter::BoundingFilter(const eckit::LocalConfiguration& conf) :
       Filter(conf),
       variable_(conf.getString(ConfKeys::Variable))
@@ -50,9 +48,8 @@ namespace bufr {
         }
     }
 
-    void BoundingFilter::apply(BufrDataMap& dataMap)
+    void BoundingFilter::updateMask(const BufrDataMap& dataMap, std::vector<char>& rowMask) const
     {
-        std::vector<size_t> validRows;
         if (dataMap.find(variable_) == dataMap.end())
         {
             std::ostringstream errStr;
@@ -70,36 +67,21 @@ namespace bufr {
                 extraDims *= dims[dimIdx];
             }
 
-            // Make local copy otherwise you get weird memory corruption issue.
-            auto rawData = var->getRawData();
-            auto array = Eigen::Map<EigArray> (rawData.data(), dims[0], extraDims);
+            const float lower = lowerLimit();
+            const float upper = upperLimit();
 
-            for (auto rowIdx = 0; rowIdx < dims[0]; rowIdx++)
+            const auto& data = var->getRawDataRef();
+            for (size_t rowIdx = 0; rowIdx < static_cast<size_t>(dims[0]); rowIdx++)
             {
-                if (lowerBound_ && upperBound_)
-                {
-                    if ((array.row(rowIdx) >= *lowerBound_).all() &&
-                        (array.row(rowIdx) <= *upperBound_).all())
-                    {
-                        validRows.push_back(rowIdx);
-                    }
-                }
-                else
+                // Branch free so the comparisons across the row vectorise.
+                const float* row = data.data() + rowIdx * extraDims;
+                bool inBounds = true;
+                for (size_t colIdx = 0; colIdx < extraDims; colIdx++)
                 {
-                    if ((lowerBound_ && (array.row(rowIdx) >= *lowerBound_).all()) ||
-                        (upperBound_ && (array.row(rowIdx) <= *upperBound_).all()))
-                    {
-                        validRows.push_back(rowIdx);
-                    }
+                    inBounds &= (row[colIdx] >= lower) & (row[colIdx] <= upper);
                 }
-            }
 
-            if (validRows.size() != static_cast<size_t>(dims[0]))
-            {
-                for (const auto& dataPair : dataMap)
-                {
-                    dataMap[dataPair.first] = dataPair.second->slice(validRows);
-                }
+                rowMask[rowIdx] &= static_cast<char>(inBounds);
             }
         }
         else
@@ -109,4 +91,40 @@ namespace bufr {
             throw eckit::BadParameter(errStr.str());
         }
     }
+
+    void BoundingFilter::addPredicates(QuerySet& querySet) const
+    {
+        const float lower = lowerLimit();
+        const float upper = upperLimit();
+
+        querySet.addPredicate(variable_, [lower, upper](const Data& data)
+        {
+            if (data.isLongStr()) return true;
+
+            for (size_t idx = 0; idx < data.size(); ++idx)
+            {
+                // Missing values are exported as the largest float.
+                const float value = data.isMissing(idx)
+                                    ? std::numeric_limits<float>::max()
+                                    : static_cast<float>(data.value.octets[idx]);
+                if (!(value >= lower && value <= upper))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        });
+    }
+
+    float BoundingFilter::lowerLimit() const
+    {
+        // A missing bound never rejects anything (NaNs are always rejected).
+        return lowerBound_ ? *lowerBound_ : -std::numeric_limits<float>::infinity();
+    }
+
+    float BoundingFilter::upperLimit() const
+    {
+        return upperBound_ ? *upperBound_ : std::numeric_limits<float>::infinity();
+    }
 }  // namespace bufr
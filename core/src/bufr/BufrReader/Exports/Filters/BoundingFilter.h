@@ -19,13 +19,22 @@ namespace bufr {
 
         virtual ~BoundingFilter() = default;
 
-        /// \brief Apply the filter to the dataevant data.
-        void apply(BufrDataMap& dataMap) final;
+        /// \brief Clear the row mask entries for rows with values outside of the bounds.
+        /// \param dataMap The data to filter.
+        /// \param rowMask One entry per row (non-zero means keep the row).
+        void updateMask(const BufrDataMap& dataMap, std::vector<char>& rowMask) const final;
+
+        /// \brief Reject whole subsets with values outside of the bounds while reading.
+        /// \param querySet The QuerySet to add the predicate to.
+        void addPredicates(QuerySet& querySet) const final;
 
-        /// \param dataMap Map to modify by filtering out rel
      private:
          const std::string variable_;
          std::shared_ptr<float> lowerBound_;
          std::shared_ptr<float> upperBound_;
+
+         /// \brief The effective bounds (infinite where a bound was not given).
+         float lowerLimit() const;
+         float upperLimit() const;
     };
 }  // namespace bufr
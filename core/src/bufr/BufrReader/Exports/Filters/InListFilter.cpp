@@ -0,0 +1,94 @@
+// (C) Copyright 2020 NOAA/NWS/NCEP/EMC
+
+#include "InListFilter.h"
+
+#include <ostream>
+
+#include "eckit/exception/Exceptions.h"
+
+namespace
+{
+    namespace ConfKeys
+    {
+        const char* Variable = "variable";
+        const char* Values = "values";
+    }  // namespace ConfKeys
+}  // namespace
+
+
+namespace bufr {
+    InListFilter::InListFilter(const eckit::LocalConfiguration& conf) :
+      Filter(conf),
+      variable_(conf.getString(ConfKeys::Variable))
+    {
+        for (const auto& value : conf.getIntVector(ConfKeys::Values))
+        {
+            values_.insert(value);
+        }
+
+        if (values_.empty())
+        {
+            std::stringstream errStr;
+            errStr << "InListFilter must contain a non-empty list of values.";
+            throw eckit::BadParameter(errStr.str());
+        }
+    }
+
+    void InListFilter::updateMask(const BufrDataMap& dataMap, std::vector<char>& rowMask) const
+    {
+        if (dataMap.find(variable_) == dataMap.end())
+        {
+            std::ostringstream errStr;
+            errStr << "Unknown variable " << variable_ << " found in inList filter.";
+            throw eckit::BadParameter(errStr.str());
+        }
+
+        const auto& var = dataMap.at(variable_);
+        if (std::dynamic_pointer_cast<DataObject<std::string>>(var))
+        {
+            std::stringstream errStr;
+            errStr << "InListFilter variable must be a array of integers (found list of strings).";
+            throw eckit::BadParameter(errStr.str());
+        }
+
+        const auto dims = var->getDims();
+        size_t extraDims = 1;
+        for (size_t dimIdx = 1; dimIdx < dims.size(); ++dimIdx)
+        {
+            extraDims *= dims[dimIdx];
+        }
+
+        for (size_t rowIdx = 0; rowIdx < static_cast<size_t>(dims[0]); rowIdx++)
+        {
+            if (!rowMask[rowIdx]) continue;
+
+            for (size_t idx = rowIdx * extraDims; idx < (rowIdx + 1) * extraDims; idx++)
+            {
+                if (var->isMissing(idx) || values_.find(var->getAsInt(idx)) == values_.end())
+                {
+                    rowMask[rowIdx] = 0;
+                    break;
+                }
+            }
+        }
+    }
+
+    void InListFilter::addPredicates(QuerySet& querySet) const
+    {
+        querySet.addPredicate(variable_, [values = values_](const Data& data)
+        {
+            if (data.isLongStr()) return true;
+
+            for (size_t idx = 0; idx < data.size(); ++idx)
+            {
+                if (data.isMissing(idx) ||
+                    values.find(static_cast<int>(data.value.octets[idx])) == values.end())
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        });
+    }
+}  // namespace bufr
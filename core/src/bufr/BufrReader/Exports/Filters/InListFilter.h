@@ -0,0 +1,36 @@
+// (C) Copyright 2020 NOAA/NWS/NCEP/EMC
+
+#pragma once
+
+#include "bufr/Filter.h"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace bufr {
+    /// \brief Class that filters integer data (ex: report type or satellite id) by only keeping
+    ///        rows whose values are all in a list of accepted values.
+    class InListFilter : public Filter
+    {
+     public:
+        /// \brief Constructor
+        /// \param conf The configuration for this filter
+        explicit InListFilter(const eckit::LocalConfiguration& conf);
+
+        virtual ~InListFilter() = default;
+
+        /// \brief Clear the row mask entries for rows with values that are not in the list.
+        /// \param dataMap The data to filter.
+        /// \param rowMask One entry per row (non-zero means keep the row).
+        void updateMask(const BufrDataMap& dataMap, std::vector<char>& rowMask) const final;
+
+        /// \brief Reject whole subsets with values that are not in the list while reading.
+        /// \param querySet The QuerySet to add the predicate to.
+        void addPredicates(QuerySet& querySet) const final;
+
+     private:
+         const std::string variable_;
+         std::unordered_set<int> values_;
+    };
+}  // namespace bufr
@@ -3,6 +3,7 @@
 #include "CategorySplit.h"
 
 #include <ostream>
+#include <set>
 
 #include "eckit/exception/Exceptions.h"
 
@@ -48,30 +49,58 @@ namespace bufr {
     {
         updateNameMap(dataMap);
 
-        std::unordered_map<std::string, BufrDataMap> dataMaps;
-
         const auto& dataObject = dataMap.at(variable_);
+        const size_t numRows = dataObject->getDims()[0];
+        const size_t rowStride = rowLength(dataObject);
 
+        // Label every row with the index of its category (or -1 if it is not wanted).
+        std::unordered_map<int, int> bucketIds;
         for (const auto& mapPair : nameMap_)
         {
-            // Find matching rows
-            std::vector<size_t> indexVec;
-            for (auto rowIdx = 0; rowIdx < dataObject->getDims()[0]; rowIdx++)
+            bucketIds.insert({mapPair.first, static_cast<int>(bucketIds.size())});
+        }
+
+        std::vector<int> rowBuckets(numRows, -1);
+        std::vector<size_t> bucketOffsets(bucketIds.size() + 1, 0);
+        for (size_t rowIdx = 0; rowIdx < numRows; rowIdx++)
+        {
+            auto bucketIt = bucketIds.find(dataObject->getAsInt(rowIdx * rowStride));
+            if (bucketIt != bucketIds.end())
             {
-                auto location = Location(dataObject->getDims().size(), 0);
-                location[0] = rowIdx;
+                rowBuckets[rowIdx] = bucketIt->second;
+                bucketOffsets[bucketIt->second + 1]++;
+            }
+        }
 
-                if (dataObject->getAsInt(location) == mapPair.first)
-                {
-                    indexVec.push_back(rowIdx);
-                }
+        // Counting sort the rows so each category owns a contiguous (ordered) range of indices.
+        for (size_t bucketIdx = 1; bucketIdx < bucketOffsets.size(); bucketIdx++)
+        {
+            bucketOffsets[bucketIdx] += bucketOffsets[bucketIdx - 1];
+        }
+
+        std::vector<size_t> sortedRows(bucketOffsets.back());
+        auto cursors = bucketOffsets;
+        for (size_t rowIdx = 0; rowIdx < numRows; rowIdx++)
+        {
+            if (rowBuckets[rowIdx] >= 0)
+            {
+                sortedRows[cursors[rowBuckets[rowIdx]]++] = rowIdx;
             }
+        }
+
+        // Make the new data maps. These are views of the rows, so nothing is copied until the
+        // data is actually needed (every row is then copied once, into its category).
+        std::unordered_map<std::string, BufrDataMap> dataMaps;
+        for (const auto& mapPair : nameMap_)
+        {
+            const auto bucketIdx = bucketIds.at(mapPair.first);
+            const std::vector<size_t> indexVec(sortedRows.begin() + bucketOffsets[bucketIdx],
+                                               sortedRows.begin() + bucketOffsets[bucketIdx + 1]);
 
-            // Make new data map
             BufrDataMap newDataMap;
             for (const auto& dataPair : dataMap)
             {
-                const auto newArr = dataPair.second->slice(indexVec);
+                const auto newArr = dataPair.second->view(indexVec);
                 newDataMap.insert({dataPair.first, newArr});
             }
 
@@ -81,31 +110,71 @@ namespace bufr {
         return dataMaps;
     }
 
-    void CategorySplit::updateNameMap(const BufrDataMap& dataMap)
+    void CategorySplit::addPredicates(QuerySet& querySet,
+                                      const std::set<std::string>& categories) const
     {
+        // Find the variable values of the categories. Automatic categories are named after
+        // their values.
+        std::set<int> values;
         if (nameMap_.empty())
         {
-            const auto& dataObject = dataMap.at(variable_);
-            for (auto rowIdx = 0; rowIdx < dataObject->getDims()[0]; rowIdx++)
+            for (const auto& category : categories)
             {
-                auto location = Location(dataObject->getDims().size(), 0);
-                location[0] = rowIdx;
-
-                if (auto dat = std::dynamic_pointer_cast<DataObject<int>> (dataObject))
+                size_t endPos = 0;
+                try
                 {
-                    auto itemVal = dat->get(location);
-                    nameMap_.insert({itemVal, std::to_string(itemVal)});
+                    const auto value = std::stoi(category, &endPos);
+                    if (endPos == category.size()) values.insert(value);
                 }
-                else
+                catch (const std::exception&)
+                {
+                    // Not an integer, so no subset can belong to it.
+                }
+            }
+        }
+        else
+        {
+            for (const auto& mapPair : nameMap_)
+            {
+                if (categories.find(mapPair.second) != categories.end())
                 {
-                    std::stringstream errStr;
-                    errStr << "Can not turn " << variable_ << " into a category as it contains ";
-                    errStr << "non-integer values.";
-                    throw eckit::BadParameter(errStr.str());
+                    values.insert(mapPair.first);
                 }
             }
         }
 
+        // Rows are split on their first value, which is the first value in the subset.
+        querySet.addPredicate(variable_, [values](const Data& data)
+        {
+            if (data.isLongStr() || data.size() == 0) return true;
+            if (data.isMissing(0)) return false;
+
+            return values.find(static_cast<int>(data.value.octets[0])) != values.end();
+        });
+    }
+
+    void CategorySplit::updateNameMap(const BufrDataMap& dataMap)
+    {
+        if (nameMap_.empty())
+        {
+            const auto& dataObject = dataMap.at(variable_);
+            auto dat = std::dynamic_pointer_cast<DataObject<int>> (dataObject);
+            if (!dat)
+            {
+                std::stringstream errStr;
+                errStr << "Can not turn " << variable_ << " into a category as it contains ";
+                errStr << "non-integer values.";
+                throw eckit::BadParameter(errStr.str());
+            }
+
+            const size_t rowStride = rowLength(dataObject);
+            for (size_t rowIdx = 0; rowIdx < static_cast<size_t>(dat->getDims()[0]); rowIdx++)
+            {
+                auto itemVal = dat->getAsInt(rowIdx * rowStride);
+                nameMap_.insert({itemVal, std::to_string(itemVal)});
+            }
+        }
+
         if (nameMap_.empty())
         {
             std::stringstream errStr;
@@ -113,4 +182,15 @@ namespace bufr {
             throw eckit::BadParameter(errStr.str());
         }
     }
+
+    size_t CategorySplit::rowLength(const std::shared_ptr<DataObjectBase>& dataObject)
+    {
+        size_t length = 1;
+        for (size_t dimIdx = 1; dimIdx < dataObject->getDims().size(); dimIdx++)
+        {
+            length *= dataObject->getDims()[dimIdx];
+        }
+
+        return length;
+    }
 }  // namespace bufr
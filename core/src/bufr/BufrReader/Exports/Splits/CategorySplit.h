@@ -4,6 +4,7 @@
 
 #include "bufr/Split.h"
 
+#include <set>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -49,6 +50,12 @@ namespace bufr {
         /// \result map of split data where the category is the key
         std::unordered_map<std::string, BufrDataMap> split(const BufrDataMap& dataMap) final;
 
+        /// \brief Only keep subsets whose variable value maps to one of the categories.
+        /// \param querySet The QuerySet to add the predicate to.
+        /// \param categories Names of the categories to keep.
+        void addPredicates(QuerySet& querySet,
+                           const std::set<std::string>& categories) const final;
+
      private:
         const std::string variable_;
 
@@ -58,5 +65,9 @@ namespace bufr {
         /// \brief Adds values to nameMap_ using the data if nameMap_ is empty.
         /// \param dataMap Data to be split
         void updateNameMap(const BufrDataMap& dataMap);
+
+        /// \brief Number of elements in one row (product of all but the first dimension).
+        /// \param dataObject The data to measure.
+        static size_t rowLength(const std::shared_ptr<DataObjectBase>& dataObject);
     };
 }  // namespace bufr
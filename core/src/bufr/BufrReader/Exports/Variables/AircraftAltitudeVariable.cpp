@@ -49,27 +49,25 @@ namespace bufr {
     {
         checkKeys(map);
 
-        std::unordered_map<std::string, std::shared_ptr<DataObjectBase>> includedFieldMap;
+        // Resolve the configured fields to typed columns once
         std::vector<std::string> includedFields;
-
-        std::shared_ptr<DataObjectBase> referenceObj = nullptr;
+        std::vector<Column<float>> columns;
         for (const auto& fieldName : FieldNames)
         {
             if (conf_.has(fieldName))
             {
-                includedFieldMap.insert({fieldName, map.at(getExportKey(fieldName))});
+                columns.push_back(column<float>(map, getExportKey(fieldName)));
                 includedFields.push_back(fieldName);
             }
         }
 
-        referenceObj = (*includedFieldMap.begin()).second;
+        const auto& referenceObj = columns.front().object();
 
         // Validation: make sure the dimensions are consistent
         auto path = referenceObj->getPath();
-        for (const auto& fieldName : FieldNames)
+        for (const auto& col : columns)
         {
-            if (includedFieldMap.find(fieldName) != includedFieldMap.end() &&
-                includedFieldMap[fieldName]->getPath() != path)
+            if (col.object()->getPath() != path)
             {
                 std::ostringstream errStr;
                 errStr << "Inconsistent dimensions found in source data.";
@@ -77,20 +75,30 @@ namespace bufr {
             }
         }
 
-        std::vector<float> aircraftAlts;
-        aircraftAlts.resize(referenceObj->size(), DataObject<float>::missingValue());
+        const Column<float>* indicatedAltitude = nullptr;
+        for (size_t fieldIdx = 0; fieldIdx < includedFields.size(); ++fieldIdx)
+        {
+            if (includedFields[fieldIdx] == ConfKeys::AircraftIndicatedAltitude)
+            {
+                indicatedAltitude = &columns[fieldIdx];
+            }
+        }
+
+        std::vector<float> aircraftAlts(referenceObj->size(), DataObject<float>::missingValue());
 
-        for (size_t idx = 0; idx < referenceObj->size(); idx++)
+        // Fields earlier in the list take precedence, so fill the values from the last one to
+        // the first (one tight loop per field).
+        for (size_t fieldIdx = includedFields.size(); fieldIdx-- > 0;)
         {
-            for (auto nameIt = includedFields.rbegin(); nameIt != includedFields.rend(); ++nameIt)
+            const auto& fieldName = includedFields[fieldIdx];
+            const auto& values = columns[fieldIdx];
+            if (fieldName == ConfKeys::Pressure)
             {
-                const auto& fieldName = *nameIt;
-                const auto& fieldValues = includedFieldMap.at(fieldName);
-                if (fieldName == ConfKeys::Pressure)
+                for (size_t idx = 0; idx < values.size(); idx++)
                 {
-                    if (!fieldValues->isMissing(idx))
+                    if (values.isValid(idx))
                     {
-                        auto value = fieldValues->getAsFloat(idx);
+                        const auto value = values[idx];
                         if (value < 22630.0f)
                         {
                             aircraftAlts[idx]  =
@@ -103,24 +111,24 @@ namespace bufr {
                                              (1.0f / 5.256f))) * (288.15f / 0.0065f);
                         }
                     }
-                    else if (includedFieldMap.find(ConfKeys::AircraftIndicatedAltitude)
-                             != includedFieldMap.end())
+                    else if (indicatedAltitude && indicatedAltitude->isValid(idx))
                     {
-                        if (!includedFieldMap[ConfKeys::AircraftIndicatedAltitude]->isMissing(idx))
-                        {
-                            aircraftAlts[idx] =
-                             includedFieldMap[ConfKeys::AircraftIndicatedAltitude]->getAsFloat(idx);
-                        }
+                        aircraftAlts[idx] = (*indicatedAltitude)[idx];
                     }
                 }
-                else if (fieldName == ConfKeys::AircraftIndicatedAltitude)
-                {
-                    // This variable is only used in conjunction with pressure.
-                    continue;
-                }
-                else if (!fieldValues->isMissing(idx))
+            }
+            else if (fieldName == ConfKeys::AircraftIndicatedAltitude)
+            {
+                // This variable is only used in conjunction with pressure.
+                continue;
+            }
+            else
+            {
+                const auto* data = values.data();
+                const auto* valid = values.validity();
+                for (size_t idx = 0; idx < values.size(); idx++)
                 {
-                    aircraftAlts[idx] = fieldValues->getAsFloat(idx);
+                    aircraftAlts[idx] = valid[idx] ? data[idx] : aircraftAlts[idx];
                 }
             }
         }
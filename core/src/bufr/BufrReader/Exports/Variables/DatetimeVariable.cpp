@@ -2,10 +2,10 @@
 
 #include "DatetimeVariable.h"
 
-#include <time.h>
 #include <climits>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <ostream>
 #include <unordered_map>
 #include <vector>
@@ -16,6 +16,7 @@
 
 
 #include "bufr/DataObject.h"
+#include "bufr/EpochTime.h"
 
 namespace
 {
@@ -55,87 +56,80 @@ namespace bufr {
 
   std::shared_ptr<DataObjectBase> DatetimeVariable::exportData(const BufrDataMap& map) {
     checkKeys(map);
-    static const int missingInt = DataObject<int>::missingValue();
 
-    setenv("TZ", "UTC", 1);             // Force UTC time zone
-    std::tm tm{};                       // zero initialise
-    tm.tm_year          = 1970 - 1900;  // 1970
-    tm.tm_mon           = 0;            // Jan=0, Feb=1, ...
-    tm.tm_mday          = 1;            // 1st
-    tm.tm_hour          = 0;            // midnight
-    tm.tm_min           = 0;
-    tm.tm_sec           = 0;
-    tm.tm_isdst         = 0;  // Not daylight saving
-    std::time_t epochDt = std::mktime(&tm);
+    // Resolve the fields to typed columns once
+    const auto year = column<int>(map, getExportKey(ConfKeys::Year));
+    const auto month = column<int>(map, getExportKey(ConfKeys::Month));
+    const auto day = column<int>(map, getExportKey(ConfKeys::Day));
+    const auto hour = column<int>(map, getExportKey(ConfKeys::Hour));
 
-    std::vector<int64_t> timeOffsets;
-    timeOffsets.reserve(map.at(getExportKey(ConfKeys::Year))->size());
+    std::unique_ptr<Column<int>> minute;
+    if (!minuteQuery_.empty()) {
+      minute = std::make_unique<Column<int>>(column<int>(map, getExportKey(ConfKeys::Minute)));
+    }
 
-    auto yearVar = map.at(getExportKey(ConfKeys::Year));
+    std::unique_ptr<Column<int>> second;
+    if (!secondQuery_.empty()) {
+      second = std::make_unique<Column<int>>(column<int>(map, getExportKey(ConfKeys::Second)));
+    }
 
     // Validation
-    if (!yearVar->hasSamePath(map.at(getExportKey(ConfKeys::Month)))
-        || !yearVar->hasSamePath(map.at(getExportKey(ConfKeys::Day)))
-        || (!minuteQuery_.empty() && !yearVar->hasSamePath(map.at(getExportKey(ConfKeys::Minute))))
-        || (!secondQuery_.empty() && !yearVar->hasSamePath(map.at(getExportKey(ConfKeys::Second))))) {
+    const auto& yearVar = year.object();
+    if (!yearVar->hasSamePath(month.object())
+        || !yearVar->hasSamePath(day.object())
+        || (minute && !yearVar->hasSamePath(minute->object()))
+        || (second && !yearVar->hasSamePath(second->object()))) {
       std::ostringstream errStr;
       errStr << "Datetime variables are not all from the same path.";
       throw eckit::BadParameter(errStr.str());
     }
 
-    for (unsigned int idx = 0; idx < map.at(getExportKey(ConfKeys::Year))->size(); idx++) {
-      int year    = map.at(getExportKey(ConfKeys::Year))->getAsInt(idx);
-      int month   = map.at(getExportKey(ConfKeys::Month))->getAsInt(idx);
-      int day     = map.at(getExportKey(ConfKeys::Day))->getAsInt(idx);
-      int hour    = map.at(getExportKey(ConfKeys::Hour))->getAsInt(idx);
-      int minutes = 0;
-      int seconds = 0;
-
-      auto diff_time = DataObject<int64_t>::missingValue();
-      if (year != missingInt && month != missingInt && day != missingInt && hour != missingInt) {
-        tm.tm_year  = year - 1900;
-        tm.tm_mon   = month - 1;
-        tm.tm_mday  = day;
-        tm.tm_hour  = hour;
-        tm.tm_min   = 0;
-        tm.tm_sec   = 0;
-        tm.tm_isdst = 0;
-
-        if (!minuteQuery_.empty()) {
-          minutes = map.at(getExportKey(ConfKeys::Minute))->getAsInt(idx);
-
-          if (minutes >= 0 && minutes < 60) {
-            tm.tm_min = minutes;
-          }
-        }
-
-        if (!secondQuery_.empty()) {
-          seconds = map.at(getExportKey(ConfKeys::Second))->getAsInt(idx);
-
-          if (seconds >= 0 && seconds < 60) {
-            tm.tm_sec = seconds;
-          }
-        }
-
-        // Be careful with mktime as it can be very slow.
-        auto thisTime = std::mktime(&tm);
-        if (thisTime < 0) {
-          log::warning() << "Caution, date suspicious date (year, month, day): " << year << ", "
-                               << month << ", " << day << std::endl;
-        }
-
-        diff_time = static_cast<int64_t>(difftime(thisTime, epochDt) + hoursFromUtc_ * 3600);
+    // Minutes and seconds outside of their normal range are ignored
+    const auto inRange = [](const std::unique_ptr<Column<int>>& values, std::vector<int>& result) {
+      if (!values) return;
+
+      const int* data = values->data();
+      for (size_t idx = 0; idx < result.size(); idx++) {
+        result[idx] = (data[idx] >= 0 && data[idx] < 60) ? data[idx] : 0;
+      }
+    };
+
+    std::vector<int> minutes(year.size(), 0);
+    std::vector<int> seconds(year.size(), 0);
+    inRange(minute, minutes);
+    inRange(second, seconds);
+
+    std::vector<int64_t> timeOffsets(year.size());
+    secondsSinceEpoch(year.size(),
+                      year.data(),
+                      month.data(),
+                      day.data(),
+                      hour.data(),
+                      minutes.data(),
+                      seconds.data(),
+                      timeOffsets.data());
+
+    static const auto missingTime = DataObject<int64_t>::missingValue();
+    for (size_t idx = 0; idx < year.size(); idx++) {
+      if (!(year.isValid(idx) && month.isValid(idx) && day.isValid(idx) && hour.isValid(idx))) {
+        timeOffsets[idx] = missingTime;
+        continue;
+      }
+
+      if (timeOffsets[idx] < 0) {
+        log::warning() << "Caution, date suspicious date (year, month, day): " << year[idx] << ", "
+                             << month[idx] << ", " << day[idx] << std::endl;
       }
 
-      timeOffsets.push_back(diff_time);
+      timeOffsets[idx] += hoursFromUtc_ * 3600;
     }
 
     return DataObjectBuilder::make<int64_t>(timeOffsets,
                                             getExportName(),
                                             groupByField_,
-                                            map.at(getExportKey(ConfKeys::Year))->getDims(),
-                                            map.at(getExportKey(ConfKeys::Year))->getPath(),
-                                            map.at(getExportKey(ConfKeys::Year))->getDimPaths());
+                                            yearVar->getDims(),
+                                            yearVar->getPath(),
+                                            yearVar->getDimPaths());
   }
 
   void DatetimeVariable::checkKeys(const BufrDataMap& map) {
@@ -0,0 +1,529 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#include "Expression.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+#include "eckit/exception/Exceptions.h"
+
+namespace
+{
+    /// \brief Number of rows each instruction processes at a time.
+    const size_t BlockSize = 256;
+
+    template <typename Func>
+    inline void unaryOp(double* values, size_t count, Func func)
+    {
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            values[idx] = func(values[idx]);
+        }
+    }
+
+    template <typename Func>
+    inline void binaryOp(double* lhs,
+                         char* lhsValid,
+                         const double* rhs,
+                         const char* rhsValid,
+                         size_t count,
+                         Func func)
+    {
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            lhs[idx] = func(lhs[idx], rhs[idx]);
+            lhsValid[idx] &= rhsValid[idx];
+        }
+    }
+}  // namespace
+
+namespace bufr {
+    Expression::Expression(const std::string& expression, const std::vector<std::string>& names) :
+      expression_(expression),
+      names_(names)
+    {
+        parseOr();
+
+        while (pos_ < expression_.size() &&
+               std::isspace(static_cast<unsigned char>(expression_[pos_])))
+        {
+            pos_++;
+        }
+        if (pos_ != expression_.size())
+        {
+            fail("Unexpected text.");
+        }
+    }
+
+    std::vector<float> Expression::evaluate(const std::vector<Column<double>>& inputs,
+                                            float missing) const
+    {
+        if (inputs.size() != names_.size())
+        {
+            std::ostringstream errStr;
+            errStr << "Expression " << expression_ << " needs " << names_.size() << " inputs.";
+            throw eckit::BadParameter(errStr.str());
+        }
+
+        const size_t size = inputs.empty() ? 0 : inputs.front().size();
+        for (const auto& input : inputs)
+        {
+            if (input.object()->getDims() != inputs.front().object()->getDims())
+            {
+                std::ostringstream errStr;
+                errStr << "The inputs of expression " << expression_ << " must all have the ";
+                errStr << "same shape.";
+                throw eckit::BadParameter(errStr.str());
+            }
+        }
+
+        std::vector<float> result(size, missing);
+        const size_t numBlocks = (size + BlockSize - 1) / BlockSize;
+
+        #pragma omp parallel
+        {
+            std::vector<double> stack(stackSize_ * BlockSize);
+            std::vector<char> stackValid(stackSize_ * BlockSize);
+
+            #pragma omp for schedule(static)
+            for (size_t blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+            {
+                const size_t start = blockIdx * BlockSize;
+                const size_t count = std::min(BlockSize, size - start);
+
+                size_t top = 0;
+                for (const auto& instruction : program_)
+                {
+                    // The top three values on the stack (before the instruction)
+                    const size_t off1 = (top > 0 ? top - 1 : 0) * BlockSize;
+                    const size_t off2 = (top > 1 ? top - 2 : 0) * BlockSize;
+                    const size_t off3 = (top > 2 ? top - 3 : 0) * BlockSize;
+                    double* v1 = stack.data() + off1;
+                    char* ok1 = stackValid.data() + off1;
+                    double* v2 = stack.data() + off2;
+                    char* ok2 = stackValid.data() + off2;
+
+                    switch (instruction.op)
+                    {
+                        case OpCode::PushInput:
+                        {
+                            const auto& input = inputs[instruction.input];
+                            std::copy(input.data() + start,
+                                      input.data() + start + count,
+                                      stack.data() + top * BlockSize);
+                            std::copy(input.validity() + start,
+                                      input.validity() + start + count,
+                                      stackValid.data() + top * BlockSize);
+                            break;
+                        }
+                        case OpCode::PushConstant:
+                            std::fill_n(stack.data() + top * BlockSize,
+                                        count,
+                                        instruction.constant);
+                            std::fill_n(stackValid.data() + top * BlockSize, count, 1);
+                            break;
+                        case OpCode::PushMissing:
+                            std::fill_n(stack.data() + top * BlockSize, count, 0.0);
+                            std::fill_n(stackValid.data() + top * BlockSize, count, 0);
+                            break;
+                        case OpCode::Negate:
+                            unaryOp(v1, count, [](double a) { return -a; });
+                            break;
+                        case OpCode::Not:
+                            unaryOp(v1, count, [](double a) { return a == 0.0 ? 1.0 : 0.0; });
+                            break;
+                        case OpCode::Abs:
+                            unaryOp(v1, count, [](double a) { return std::fabs(a); });
+                            break;
+                        case OpCode::Sqrt:
+                            unaryOp(v1, count, [](double a) { return std::sqrt(a); });
+                            break;
+                        case OpCode::Exp:
+                            unaryOp(v1, count, [](double a) { return std::exp(a); });
+                            break;
+                        case OpCode::Log:
+                            unaryOp(v1, count, [](double a) { return std::log(a); });
+                            break;
+                        case OpCode::Log10:
+                            unaryOp(v1, count, [](double a) { return std::log10(a); });
+                            break;
+                        case OpCode::Floor:
+                            unaryOp(v1, count, [](double a) { return std::floor(a); });
+                            break;
+                        case OpCode::Ceil:
+                            unaryOp(v1, count, [](double a) { return std::ceil(a); });
+                            break;
+                        case OpCode::Add:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return a + b; });
+                            break;
+                        case OpCode::Subtract:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return a - b; });
+                            break;
+                        case OpCode::Multiply:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return a * b; });
+                            break;
+                        case OpCode::Divide:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return a / b; });
+                            break;
+                        case OpCode::Power:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return std::pow(a, b); });
+                            break;
+                        case OpCode::Min:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return std::min(a, b); });
+                            break;
+                        case OpCode::Max:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return std::max(a, b); });
+                            break;
+                        case OpCode::Less:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return a < b ? 1.0 : 0.0; });
+                            break;
+                        case OpCode::LessEqual:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return a <= b ? 1.0 : 0.0; });
+                            break;
+                        case OpCode::Greater:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return a > b ? 1.0 : 0.0; });
+                            break;
+                        case OpCode::GreaterEqual:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return a >= b ? 1.0 : 0.0; });
+                            break;
+                        case OpCode::Equal:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return a == b ? 1.0 : 0.0; });
+                            break;
+                        case OpCode::NotEqual:
+                            binaryOp(v2, ok2, v1, ok1, count,
+                                     [](double a, double b) { return a != b ? 1.0 : 0.0; });
+                            break;
+                        case OpCode::And:
+                            binaryOp(v2, ok2, v1, ok1, count, [](double a, double b)
+                                     { return (a != 0.0 && b != 0.0) ? 1.0 : 0.0; });
+                            break;
+                        case OpCode::Or:
+                            binaryOp(v2, ok2, v1, ok1, count, [](double a, double b)
+                                     { return (a != 0.0 || b != 0.0) ? 1.0 : 0.0; });
+                            break;
+                        case OpCode::Where:
+                        {
+                            double* cond = stack.data() + off3;
+                            char* condOk = stackValid.data() + off3;
+                            for (size_t idx = 0; idx < count; ++idx)
+                            {
+                                const bool isTrue = cond[idx] != 0.0;
+                                cond[idx] = isTrue ? v2[idx] : v1[idx];
+                                condOk[idx] &= isTrue ? ok2[idx] : ok1[idx];
+                            }
+                            break;
+                        }
+                    }
+
+                    top = top + 1 - arity(instruction.op);
+                }
+
+                // Missing and non-finite (or out of range) results become the missing value
+                float* out = result.data() + start;
+                for (size_t idx = 0; idx < count; ++idx)
+                {
+                    const bool isValid = stackValid[idx] && std::fabs(stack[idx]) <= FLT_MAX;
+                    out[idx] = isValid ? static_cast<float>(stack[idx]) : missing;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    void Expression::parseOr()
+    {
+        parseAnd();
+        while (accept("||"))
+        {
+            parseAnd();
+            emit(OpCode::Or);
+        }
+    }
+
+    void Expression::parseAnd()
+    {
+        parseComparison();
+        while (accept("&&"))
+        {
+            parseComparison();
+            emit(OpCode::And);
+        }
+    }
+
+    void Expression::parseComparison()
+    {
+        // Two character operators first so "<=" isn't read as "<"
+        static const std::vector<std::pair<std::string, OpCode>> Comparisons =
+            {{"<=", OpCode::LessEqual},
+             {">=", OpCode::GreaterEqual},
+             {"==", OpCode::Equal},
+             {"!=", OpCode::NotEqual},
+             {"<", OpCode::Less},
+             {">", OpCode::Greater}};
+
+        parseSum();
+        for (const auto& comparison : Comparisons)
+        {
+            if (accept(comparison.first))
+            {
+                parseSum();
+                emit(comparison.second);
+                break;
+            }
+        }
+    }
+
+    void Expression::parseSum()
+    {
+        parseProduct();
+        while (true)
+        {
+            if (accept("+"))
+            {
+                parseProduct();
+                emit(OpCode::Add);
+            }
+            else if (accept("-"))
+            {
+                parseProduct();
+                emit(OpCode::Subtract);
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    void Expression::parseProduct()
+    {
+        parseUnary();
+        while (true)
+        {
+            if (accept("*"))
+            {
+                parseUnary();
+                emit(OpCode::Multiply);
+            }
+            else if (accept("/"))
+            {
+                parseUnary();
+                emit(OpCode::Divide);
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    void Expression::parseUnary()
+    {
+        if (accept("-"))
+        {
+            parseUnary();
+            emit(OpCode::Negate);
+        }
+        else if (accept("!"))
+        {
+            parseUnary();
+            emit(OpCode::Not);
+        }
+        else
+        {
+            parsePower();
+        }
+    }
+
+    void Expression::parsePower()
+    {
+        parsePrimary();
+        if (accept("^"))
+        {
+            parseUnary();
+            emit(OpCode::Power);
+        }
+    }
+
+    void Expression::parsePrimary()
+    {
+        static const std::unordered_map<std::string, std::pair<OpCode, size_t>> Functions =
+            {{"where", {OpCode::Where, 3}},
+             {"abs", {OpCode::Abs, 1}},
+             {"sqrt", {OpCode::Sqrt, 1}},
+             {"exp", {OpCode::Exp, 1}},
+             {"log", {OpCode::Log, 1}},
+             {"log10", {OpCode::Log10, 1}},
+             {"floor", {OpCode::Floor, 1}},
+             {"ceil", {OpCode::Ceil, 1}},
+             {"min", {OpCode::Min, 2}},
+             {"max", {OpCode::Max, 2}},
+             {"pow", {OpCode::Power, 2}}};
+
+        if (accept("("))
+        {
+            parseOr();
+            expect(")");
+            return;
+        }
+
+        if (pos_ >= expression_.size())
+        {
+            fail("Expected a value.");
+        }
+
+        // The character functions need the char as an unsigned char
+        const auto nextChar = static_cast<unsigned char>(expression_[pos_]);
+        if (std::isdigit(nextChar) || nextChar == '.')
+        {
+            const char* start = expression_.c_str() + pos_;
+            char* end = nullptr;
+            const double value = std::strtod(start, &end);
+            if (end == start)
+            {
+                fail("Invalid number.");
+            }
+
+            pos_ += static_cast<size_t>(end - start);
+            emit(OpCode::PushConstant, 0, value);
+            return;
+        }
+
+        if (!(std::isalpha(nextChar) || nextChar == '_'))
+        {
+            fail("Expected a value.");
+        }
+
+        const size_t nameStart = pos_;
+        while (pos_ < expression_.size() &&
+               (std::isalnum(static_cast<unsigned char>(expression_[pos_])) ||
+                expression_[pos_] == '_'))
+        {
+            pos_++;
+        }
+
+        const auto name = expression_.substr(nameStart, pos_ - nameStart);
+
+        if (accept("("))
+        {
+            const auto funcIt = Functions.find(name);
+            if (funcIt == Functions.end())
+            {
+                fail("Unknown function " + name + ".");
+            }
+
+            for (size_t argIdx = 0; argIdx < funcIt->second.second; ++argIdx)
+            {
+                if (argIdx > 0) expect(",");
+                parseOr();
+            }
+
+            expect(")");
+            emit(funcIt->second.first);
+        }
+        else if (name == "missing")
+        {
+            emit(OpCode::PushMissing);
+        }
+        else
+        {
+            const auto nameIt = std::find(names_.begin(), names_.end(), name);
+            if (nameIt == names_.end())
+            {
+                fail("Unknown variable " + name + ".");
+            }
+
+            emit(OpCode::PushInput, static_cast<size_t>(nameIt - names_.begin()));
+        }
+    }
+
+    bool Expression::accept(const std::string& token)
+    {
+        while (pos_ < expression_.size() &&
+               std::isspace(static_cast<unsigned char>(expression_[pos_])))
+        {
+            pos_++;
+        }
+
+        if (expression_.compare(pos_, token.size(), token) == 0)
+        {
+            pos_ += token.size();
+            return true;
+        }
+
+        return false;
+    }
+
+    void Expression::expect(const std::string& token)
+    {
+        if (!accept(token))
+        {
+            fail("Expected \"" + token + "\".");
+        }
+    }
+
+    void Expression::emit(OpCode op, size_t input, double constant)
+    {
+        Instruction instruction;
+        instruction.op = op;
+        instruction.input = input;
+        instruction.constant = constant;
+        program_.push_back(instruction);
+
+        // Keep track of how deep the stack gets
+        depth_ = depth_ + 1 - arity(op);
+        stackSize_ = std::max(stackSize_, depth_);
+    }
+
+    [[noreturn]] void Expression::fail(const std::string& message) const
+    {
+        std::ostringstream errStr;
+        errStr << "Error in expression \"" << expression_ << "\" at position " << pos_ << ": ";
+        errStr << message;
+        throw eckit::BadParameter(errStr.str());
+    }
+
+    size_t Expression::arity(OpCode op)
+    {
+        switch (op)
+        {
+            case OpCode::PushInput:
+            case OpCode::PushConstant:
+            case OpCode::PushMissing:
+                return 0;
+            case OpCode::Negate:
+            case OpCode::Not:
+            case OpCode::Abs:
+            case OpCode::Sqrt:
+            case OpCode::Exp:
+            case OpCode::Log:
+            case OpCode::Log10:
+            case OpCode::Floor:
+            case OpCode::Ceil:
+                return 1;
+            case OpCode::Where:
+                return 3;
+            default:
+                return 2;
+        }
+    }
+}  // namespace bufr
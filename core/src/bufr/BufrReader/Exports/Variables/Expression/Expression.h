@@ -0,0 +1,123 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "bufr/Column.h"
+
+namespace bufr {
+    /// \brief Arithmetic expression over named input columns (ex: "where(qc < 4, t - 273.15,
+    ///        missing)").
+    /// \details The expression is parsed once and compiled to a small stack bytecode. Evaluating
+    ///          it runs each instruction over a block of rows at a time (so every instruction is
+    ///          a tight loop over arrays) and the blocks are evaluated in parallel. Every value
+    ///          carries a validity flag: the result of an operation is missing if any of its
+    ///          inputs is missing (where only looks at the branch it selects), and results that
+    ///          are not finite (ex: division by zero) are missing.
+    ///
+    ///          Supported syntax (highest to lowest precedence):
+    ///            numbers, input names, missing, (...), functions
+    ///            ^ (power, right associative)
+    ///            unary - and !
+    ///            * /
+    ///            + -
+    ///            < <= > >= == !=
+    ///            &&
+    ///            ||
+    ///          Functions: where(condition, a, b), abs, sqrt, exp, log, log10, floor, ceil,
+    ///          min(a, b), max(a, b) and pow(a, b). Comparisons and logical operators return 1
+    ///          or 0.
+    class Expression
+    {
+     public:
+        /// \brief Parse and compile the expression.
+        /// \param expression The expression text.
+        /// \param names Names of the inputs the expression can refer to (in the order the
+        ///        inputs are given to evaluate).
+        Expression(const std::string& expression, const std::vector<std::string>& names);
+
+        /// \brief Evaluate the expression for every row.
+        /// \param inputs One column per input name (all the same shape).
+        /// \param missing The value to use for missing results.
+        /// \result The values of the expression.
+        std::vector<float> evaluate(const std::vector<Column<double>>& inputs,
+                                    float missing) const;
+
+        /// \brief Get the expression text.
+        inline std::string str() const { return expression_; }
+
+     private:
+        enum class OpCode
+        {
+            PushInput,
+            PushConstant,
+            PushMissing,
+            Negate,
+            Not,
+            Add,
+            Subtract,
+            Multiply,
+            Divide,
+            Power,
+            Less,
+            LessEqual,
+            Greater,
+            GreaterEqual,
+            Equal,
+            NotEqual,
+            And,
+            Or,
+            Where,
+            Abs,
+            Sqrt,
+            Exp,
+            Log,
+            Log10,
+            Floor,
+            Ceil,
+            Min,
+            Max
+        };
+
+        struct Instruction
+        {
+            OpCode op;
+            size_t input = 0;
+            double constant = 0.0;
+        };
+
+        const std::string expression_;
+        const std::vector<std::string> names_;
+        std::vector<Instruction> program_;
+        size_t stackSize_ = 0;
+
+        // Recursive descent parser (each level emits the bytecode for its operators).
+        size_t pos_ = 0;
+        size_t depth_ = 0;
+        void parseOr();
+        void parseAnd();
+        void parseComparison();
+        void parseSum();
+        void parseProduct();
+        void parseUnary();
+        void parsePower();
+        void parsePrimary();
+
+        /// \brief Skip whitespace and consume the token if it is next.
+        bool accept(const std::string& token);
+
+        /// \brief Consume the token or throw.
+        void expect(const std::string& token);
+
+        /// \brief Add an instruction to the program.
+        void emit(OpCode op, size_t input = 0, double constant = 0.0);
+
+        /// \brief Throw an error that points at the current position.
+        [[noreturn]] void fail(const std::string& message) const;
+
+        /// \brief Number of values each instruction pops from the stack.
+        static size_t arity(OpCode op);
+    };
+}  // namespace bufr
@@ -0,0 +1,94 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#include "ExpressionVariable.h"
+
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "bufr/DataObject.h"
+#include "../../../DataObjectBuilder.h"
+
+namespace
+{
+    namespace ConfKeys
+    {
+        const char* Formula = "formula";
+        const char* Variables = "variables";
+    }  // namespace ConfKeys
+
+    std::vector<std::string> variableNames(const eckit::LocalConfiguration& conf)
+    {
+        if (!conf.has(ConfKeys::Formula) || !conf.has(ConfKeys::Variables))
+        {
+            throw eckit::BadParameter("Expression variables need a formula and a map of "
+                                      "variables. Check your configuration.");
+        }
+
+        const auto names = conf.getSubConfiguration(ConfKeys::Variables).keys();
+        if (names.empty())
+        {
+            throw eckit::BadParameter("Expression variables need at least one variable. Check "
+                                      "your configuration.");
+        }
+
+        return names;
+    }
+}  // namespace
+
+
+namespace bufr {
+    ExpressionVariable::ExpressionVariable(const std::string& exportName,
+                                           const std::string& groupByField,
+                                           const eckit::LocalConfiguration &conf) :
+      Variable(exportName, groupByField, conf),
+      names_(variableNames(conf)),
+      expression_(conf.getString(ConfKeys::Formula), names_)
+    {
+        initQueryMap();
+    }
+
+    std::shared_ptr<DataObjectBase> ExpressionVariable::exportData(const BufrDataMap& map)
+    {
+        std::vector<Column<double>> inputs;
+        inputs.reserve(names_.size());
+        for (const auto& name : names_)
+        {
+            inputs.push_back(column<double>(map, getExportKey(name)));
+        }
+
+        const auto values = expression_.evaluate(inputs, DataObject<float>::missingValue());
+
+        // The result has the shape of the first field
+        const auto& refObj = inputs.front().object();
+        return DataObjectBuilder::make<float>(values,
+                                              getExportName(),
+                                              groupByField_,
+                                              refObj->getDims(),
+                                              refObj->getPath(),
+                                              refObj->getDimPaths());
+    }
+
+    QueryList ExpressionVariable::makeQueryList() const
+    {
+        auto queries = QueryList();
+
+        const auto variablesConf = conf_.getSubConfiguration(ConfKeys::Variables);
+        for (const auto& name : names_)
+        {
+            QueryInfo info;
+            info.name = getExportKey(name);
+            info.query = variablesConf.getString(name);
+            info.groupByField = groupByField_;
+            queries.push_back(info);
+        }
+
+        return queries;
+    }
+
+    std::string ExpressionVariable::getExportKey(const std::string& name) const
+    {
+        return getExportName() + "_" + name;
+    }
+}  // namespace bufr
@@ -0,0 +1,46 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "eckit/config/LocalConfiguration.h"
+
+#include "bufr/Variable.h"
+
+#include "Expression/Expression.h"
+
+
+namespace bufr {
+    /// \brief Exports the result of an arithmetic expression (ex: "t - 273.15") evaluated over
+    ///        other queried fields.
+    class ExpressionVariable final : public Variable
+    {
+     public:
+        ExpressionVariable() = delete;
+        ExpressionVariable(const std::string& exportName,
+                           const std::string& groupByField,
+                           const eckit::LocalConfiguration& conf);
+
+        ~ExpressionVariable() final = default;
+
+        /// \brief Evaluate the expression over the queried fields
+        /// \param map BufrDataMap that contains the parsed data for each query
+        std::shared_ptr<DataObjectBase> exportData(const BufrDataMap& map) final;
+
+        /// \brief Get a list of queries for this variable
+        QueryList makeQueryList() const final;
+
+     private:
+        /// \brief Names the expression uses for the queried fields
+        const std::vector<std::string> names_;
+
+        /// \brief The compiled expression
+        const Expression expression_;
+
+        /// \brief get the export key string
+        std::string getExportKey(const std::string& name) const;
+    };
+}  // namespace bufr
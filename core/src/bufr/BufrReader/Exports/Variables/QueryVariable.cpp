@@ -13,6 +13,7 @@ namespace
     {
         const char *Query = "query";
         const char *Type = "type";
+        const char *Dictionary = "dictionary";
     }
 }
 
@@ -21,7 +22,8 @@ namespace bufr {
     QueryVariable::QueryVariable(const std::string& exportName,
                                  const std::string& groupByField,
                                  const eckit::LocalConfiguration& conf) :
-        Variable(exportName, groupByField, conf)
+        Variable(exportName, groupByField, conf),
+        transform_(TransformBuilder::makeFusedTransform(conf))
     {
         initQueryMap();
     }
@@ -38,9 +40,23 @@ namespace bufr {
 
         auto dataObject = map.at(getExportName());
 
-        for (const auto& transform : TransformBuilder::makeTransforms(conf_))
+        if (transform_)
         {
-            transform->apply(dataObject);
+            transform_->apply(dataObject);
+        }
+
+        if (conf_.has(ConfKeys::Dictionary) && conf_.getBool(ConfKeys::Dictionary))
+        {
+            auto strObject = std::dynamic_pointer_cast<DataObject<std::string>>(dataObject);
+            if (!strObject)
+            {
+                std::stringstream errStr;
+                errStr << "Export named " << getExportName();
+                errStr << " can only use dictionary encoding with string data.";
+                throw eckit::BadParameter(errStr.str());
+            }
+
+            strObject->encodeDictionary();
         }
 
         return dataObject;
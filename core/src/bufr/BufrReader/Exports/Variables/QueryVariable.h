@@ -31,5 +31,12 @@ namespace bufr {
 
         /// \brief Get a list of queries for this variable
         QueryList makeQueryList() const final;
+
+        /// \brief Are there transforms to apply to the queried values
+        bool hasTransforms() const final { return transform_ != nullptr; }
+
+     private:
+        /// \brief The configured transforms fused into one (nullptr if there are none).
+        const std::shared_ptr<Transform> transform_;
     };
 }  // namespace bufr
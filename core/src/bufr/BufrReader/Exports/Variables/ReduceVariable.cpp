@@ -0,0 +1,255 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#include "ReduceVariable.h"
+
+#include <algorithm>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "bufr/Column.h"
+#include "bufr/DataObject.h"
+#include "../../../DataObjectBuilder.h"
+
+namespace
+{
+    namespace ConfKeys
+    {
+        const char* Query = "query";
+        const char* Operation = "operation";
+        const char* Dimension = "dimension";
+    }  // namespace ConfKeys
+
+    bufr::ReduceVariable::Operation operationFromConf(const eckit::LocalConfiguration& conf)
+    {
+        static const std::unordered_map<std::string, bufr::ReduceVariable::Operation> Operations =
+            {{"count", bufr::ReduceVariable::Operation::Count},
+             {"min", bufr::ReduceVariable::Operation::Min},
+             {"max", bufr::ReduceVariable::Operation::Max},
+             {"mean", bufr::ReduceVariable::Operation::Mean},
+             {"first", bufr::ReduceVariable::Operation::First}};
+
+        if (!conf.has(ConfKeys::Query) || !conf.has(ConfKeys::Operation))
+        {
+            throw eckit::BadParameter("Reduce variables need a query and an operation. Check "
+                                      "your configuration.");
+        }
+
+        const auto name = conf.getString(ConfKeys::Operation);
+        const auto opIt = Operations.find(name);
+        if (opIt == Operations.end())
+        {
+            std::ostringstream errStr;
+            errStr << "Unknown reduce operation " << name << ". Must be one of count, min, max, ";
+            errStr << "mean or first.";
+            throw eckit::BadParameter(errStr.str());
+        }
+
+        return opIt->second;
+    }
+
+    size_t dimensionFromConf(const eckit::LocalConfiguration& conf)
+    {
+        const int dimension = conf.getInt(ConfKeys::Dimension, 1);
+        if (dimension < 1)
+        {
+            throw eckit::BadParameter("The reduce dimension must be a repeated dimension (1 or "
+                                      "more).");
+        }
+
+        return static_cast<size_t>(dimension);
+    }
+}  // namespace
+
+
+namespace bufr {
+    ReduceVariable::ReduceVariable(const std::string& exportName,
+                                   const std::string& groupByField,
+                                   const eckit::LocalConfiguration &conf) :
+      Variable(exportName, groupByField, conf),
+      operation_(operationFromConf(conf)),
+      dimension_(dimensionFromConf(conf))
+    {
+        initQueryMap();
+    }
+
+    std::shared_ptr<DataObjectBase> ReduceVariable::exportData(const BufrDataMap& map)
+    {
+        auto objIt = map.find(getExportKey());
+        if (objIt == map.end())
+        {
+            std::ostringstream errStr;
+            errStr << "Query " << getExportKey() << " could not be found during export of ";
+            errStr << getExportName() << ".";
+            throw eckit::BadParameter(errStr.str());
+        }
+
+        const auto& object = objIt->second;
+        if (std::dynamic_pointer_cast<DataObject<float>>(object)) return reduce<float>(object);
+        if (std::dynamic_pointer_cast<DataObject<double>>(object)) return reduce<double>(object);
+        if (std::dynamic_pointer_cast<DataObject<int32_t>>(object)) return reduce<int32_t>(object);
+        if (std::dynamic_pointer_cast<DataObject<uint32_t>>(object))
+            return reduce<uint32_t>(object);
+        if (std::dynamic_pointer_cast<DataObject<int64_t>>(object)) return reduce<int64_t>(object);
+        if (std::dynamic_pointer_cast<DataObject<uint64_t>>(object))
+            return reduce<uint64_t>(object);
+
+        std::ostringstream errStr;
+        errStr << "Can't reduce " << getExportName() << " because its query does not return ";
+        errStr << "numbers.";
+        throw eckit::BadParameter(errStr.str());
+    }
+
+    template <typename T>
+    std::shared_ptr<DataObjectBase>
+        ReduceVariable::reduce(const std::shared_ptr<DataObjectBase>& object) const
+    {
+        const auto dims = object->getDims();
+        if (dimension_ >= dims.size())
+        {
+            std::ostringstream errStr;
+            errStr << "Can't reduce " << getExportName() << " over dimension " << dimension_;
+            errStr << " because its query only has " << dims.size() << " dimensions.";
+            throw eckit::BadParameter(errStr.str());
+        }
+
+        // View the values as [outer][reduced][inner]
+        size_t outer = 1;
+        size_t inner = 1;
+        for (size_t dimIdx = 0; dimIdx < dims.size(); ++dimIdx)
+        {
+            if (dimIdx < dimension_) outer *= static_cast<size_t>(dims[dimIdx]);
+            if (dimIdx > dimension_) inner *= static_cast<size_t>(dims[dimIdx]);
+        }
+
+        const size_t reduced = static_cast<size_t>(dims[dimension_]);
+
+        auto outDims = dims;
+        outDims.erase(outDims.begin() + dimension_);
+
+        auto outDimPaths = object->getDimPaths();
+        if (dimension_ < outDimPaths.size())
+        {
+            outDimPaths.erase(outDimPaths.begin() + dimension_);
+        }
+
+        const auto column = Column<T>(object);
+        const T* values = column.data();
+        const char* valid = column.validity();
+
+        // Applies func(outIdx, value) to the valid values that reduce into each output element
+        auto forEachValid = [&](auto func)
+        {
+            #pragma omp parallel for schedule(static)
+            for (size_t outerIdx = 0; outerIdx < outer; ++outerIdx)
+            {
+                for (size_t reducedIdx = 0; reducedIdx < reduced; ++reducedIdx)
+                {
+                    const size_t start = (outerIdx * reduced + reducedIdx) * inner;
+                    for (size_t innerIdx = 0; innerIdx < inner; ++innerIdx)
+                    {
+                        if (valid[start + innerIdx])
+                        {
+                            func(outerIdx * inner + innerIdx, values[start + innerIdx]);
+                        }
+                    }
+                }
+            }
+        };
+
+        const size_t outSize = outer * inner;
+        switch (operation_)
+        {
+            case Operation::Count:
+            {
+                std::vector<int> counts(outSize, 0);
+                forEachValid([&counts](size_t idx, T) { counts[idx]++; });
+
+                return DataObjectBuilder::make<int>(counts,
+                                                    getExportName(),
+                                                    groupByField_,
+                                                    outDims,
+                                                    object->getPath(),
+                                                    outDimPaths);
+            }
+            case Operation::Mean:
+            {
+                using MeanType = typename std::conditional<std::is_same<T, double>::value,
+                                                           double,
+                                                           float>::type;
+
+                std::vector<double> sums(outSize, 0.0);
+                std::vector<int> counts(outSize, 0);
+                forEachValid([&sums, &counts](size_t idx, T value)
+                             {
+                                 sums[idx] += static_cast<double>(value);
+                                 counts[idx]++;
+                             });
+
+                std::vector<MeanType> means(outSize, DataObject<MeanType>::missingValue());
+                for (size_t idx = 0; idx < outSize; ++idx)
+                {
+                    if (counts[idx] > 0)
+                    {
+                        means[idx] = static_cast<MeanType>(sums[idx] / counts[idx]);
+                    }
+                }
+
+                return DataObjectBuilder::make<MeanType>(means,
+                                                         getExportName(),
+                                                         groupByField_,
+                                                         outDims,
+                                                         object->getPath(),
+                                                         outDimPaths);
+            }
+            default:
+            {
+                std::vector<T> result(outSize, DataObject<T>::missingValue());
+                std::vector<char> found(outSize, 0);
+
+                const auto op = operation_;
+                forEachValid([&result, &found, op](size_t idx, T value)
+                             {
+                                 if (!found[idx])
+                                 {
+                                     result[idx] = value;
+                                     found[idx] = 1;
+                                 }
+                                 else if (op == Operation::Min)
+                                 {
+                                     result[idx] = std::min(result[idx], value);
+                                 }
+                                 else if (op == Operation::Max)
+                                 {
+                                     result[idx] = std::max(result[idx], value);
+                                 }
+                             });
+
+                return DataObjectBuilder::make<T>(result,
+                                                  getExportName(),
+                                                  groupByField_,
+                                                  outDims,
+                                                  object->getPath(),
+                                                  outDimPaths);
+            }
+        }
+    }
+
+    QueryList ReduceVariable::makeQueryList() const
+    {
+        QueryInfo info;
+        info.name = getExportKey();
+        info.query = conf_.getString(ConfKeys::Query);
+        info.groupByField = groupByField_;
+
+        return {info};
+    }
+
+    std::string ReduceVariable::getExportKey() const
+    {
+        return getExportName() + "_" + ConfKeys::Query;
+    }
+}  // namespace bufr
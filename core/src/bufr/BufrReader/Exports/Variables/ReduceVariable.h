@@ -0,0 +1,58 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "eckit/config/LocalConfiguration.h"
+
+#include "bufr/Variable.h"
+
+
+namespace bufr {
+    /// \brief Exports a reduction (count, min, max, mean or first valid value) of a queried
+    ///        field over one of its repeated dimensions (ex: the number of levels per location).
+    class ReduceVariable final : public Variable
+    {
+     public:
+        /// \brief The supported reductions.
+        enum class Operation
+        {
+            Count,
+            Min,
+            Max,
+            Mean,
+            First
+        };
+
+        ReduceVariable() = delete;
+        ReduceVariable(const std::string& exportName,
+                       const std::string& groupByField,
+                       const eckit::LocalConfiguration& conf);
+
+        ~ReduceVariable() final = default;
+
+        /// \brief Reduce the queried field over the configured dimension
+        /// \param map BufrDataMap that contains the parsed data for each query
+        std::shared_ptr<DataObjectBase> exportData(const BufrDataMap& map) final;
+
+        /// \brief Get a list of queries for this variable
+        QueryList makeQueryList() const final;
+
+     private:
+        /// \brief The reduction to apply
+        const Operation operation_;
+
+        /// \brief Index of the dimension to reduce over (1 for the first repeated dimension)
+        const size_t dimension_;
+
+        /// \brief Reduce a field whose values have type T.
+        template <typename T>
+        std::shared_ptr<DataObjectBase> reduce(const std::shared_ptr<DataObjectBase>& object) const;
+
+        /// \brief get the export key string
+        std::string getExportKey() const;
+    };
+}  // namespace bufr
@@ -50,9 +50,10 @@ namespace bufr {
         checkKeys(map);
 
         // Read the variables from the map
-        auto& radObj = map.at(getExportKey(ConfKeys::BrightnessTemperature));
-        auto& sensorChanObj = map.at(getExportKey(ConfKeys::SensorChannelNumber));
-        auto& fovnObj = map.at(getExportKey(ConfKeys::FieldOfViewNumber));
+        const auto rad = column<float>(map, getExportKey(ConfKeys::BrightnessTemperature));
+        const auto channel = column<int>(map, getExportKey(ConfKeys::SensorChannelNumber));
+        const auto fovn = column<int>(map, getExportKey(ConfKeys::FieldOfViewNumber));
+        const auto& radObj = rad.object();
 
         // Get dimensions
         if (radObj->getDims().size() != 2)
@@ -66,41 +67,32 @@ namespace bufr {
 
         // Declare and initialize scanline array
         // scanline has the same dimension as fovn
-        std::vector<int> scanline(fovnObj->size(), DataObject<int>::missingValue());
+        std::vector<int> scanline(fovn.size(), DataObject<int>::missingValue());
 
         // Get observation time (obstime) variable
         auto datetimeObj = datetime_.exportData(map);
-        std::vector<int64_t> obstime;
-        obstime = std::dynamic_pointer_cast<DataObject<int64_t>>(datetimeObj)->getRawData();
+        const auto& obstime =
+            std::dynamic_pointer_cast<DataObject<int64_t>>(datetimeObj)->getRawDataRef();
 
-        // Get field-of-view number
-        std::vector<int> fovn(fovnObj->size(), DataObject<int>::missingValue());
-        for (size_t idx = 0; idx < fovnObj->size(); idx++)
-        {
-           fovn[idx] = fovnObj->getAsInt(idx);
-        }
-
-        // Get sensor channel
-        std::vector<int> channel(sensorChanObj->size(), DataObject<int>::missingValue());
-        for (size_t idx = 0; idx < sensorChanObj->size(); idx++)
-        {
-           channel[idx] = sensorChanObj->getAsInt(idx);
-        }
-
-        // Get brightness temperature (observation)
-        std::vector<float> btobs(radObj->size(), DataObject<float>::missingValue());
-        for (size_t idx = 0; idx < radObj->size(); idx++)
-        {
-           btobs[idx] = radObj->getAsFloat(idx);
-        }
+        // The brightness temperatures are remapped in place, so they are the only input that is
+        // copied (the other inputs are passed straight from the data objects).
+        std::vector<float> btobs(rad.data(), rad.data() + rad.size());
 
         // Perform FFT image remapping
         // input only variables: nobs, nchn obstime, fovn, channel
         // input & output variables: btobs, scanline, error_status
         if (nobs > 0) {
+            // The Fortran interface takes the address of each buffer pointer (type(c_ptr)
+            // passed by reference).
+            void* obstimePtr = const_cast<int64_t*>(obstime.data());
+            void* fovnPtr = const_cast<int*>(fovn.data());
+            void* channelPtr = const_cast<int*>(channel.data());
+            void* btobsPtr = btobs.data();
+            void* scanlinePtr = scanline.data();
+
             int error_status;
-	    ATMS_Spatial_Average_f(nobs, nchn, &obstime, &fovn, &channel, &btobs,
-                                               &scanline, &error_status);
+            ATMS_Spatial_Average_f(nobs, nchn, &obstimePtr, &fovnPtr, &channelPtr, &btobsPtr,
+                                   &scanlinePtr, &error_status);
         }
 
         // Export remapped observation (btobs)
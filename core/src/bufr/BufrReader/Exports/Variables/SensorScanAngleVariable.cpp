@@ -72,55 +72,35 @@ namespace bufr {
         }
 
         // Read the variables from the map
-
-        auto& fovnObj = map.at(getExportKey(ConfKeys::FieldOfViewNumber));
+        const auto fovn = column<int>(map, getExportKey(ConfKeys::FieldOfViewNumber));
+        const auto& fovnObj = fovn.object();
+        const int* fovnData = fovn.data();
 
         // Declare and initialize scanline array
         // scanline has the same dimension as fovn
-        std::vector<float> scanang(fovnObj->size(), DataObject<float>::missingValue());
-        std::vector<int> scanpos(fovnObj->size(), DataObject<int>::missingValue());
-
-        // Get field-of-view number
-        std::vector<int> fovn(fovnObj->size(), DataObject<int>::missingValue());
-        for (size_t idx = 0; idx < fovnObj->size(); idx++)
-        {
-           fovn[idx] = fovnObj->getAsInt(idx);
-        }
+        std::vector<float> scanang(fovn.size(), DataObject<float>::missingValue());
 
         if (sensor == "iasi")
         {
-           for (size_t idx = 0; idx < fovnObj->size(); idx++)
-           {
-              scanpos[idx] = (fovnObj->getAsInt(idx) - 1) / 2 + 1;
-           }
-        }
-        else
-        {
-           for (size_t idx = 0; idx < fovnObj->size(); idx++)
+           // The step adjustment is negative until the first odd scan position.
+           size_t firstOdd = 0;
+           while (firstOdd < fovn.size() && ((fovnData[firstOdd] - 1) / 2 + 1) % 2 != 1)
            {
-              scanpos[idx] = fovnObj->getAsInt(idx);
+              firstOdd++;
            }
-        }
 
-        if (sensor == "iasi")
-        {
-           float tmp;
-           tmp = -stepAdj;
            // Calculate sensor scan angle
-           for (size_t idx = 0; idx < fovnObj->size(); idx++)
+           for (size_t idx = 0; idx < fovn.size(); idx++)
            {
-              if (scanpos[idx] % 2 == 1)
-              {
-                 tmp = stepAdj;
-              }
-              scanang[idx] = start + static_cast<float>((fovn[idx]-1)/4) * step + tmp;
+              const float tmp = idx < firstOdd ? -stepAdj : stepAdj;
+              scanang[idx] = start + static_cast<float>((fovnData[idx] - 1) / 4) * step + tmp;
            }
         }
         else
         {
-           for (size_t idx = 0; idx < fovnObj->size(); idx++)
+           for (size_t idx = 0; idx < fovn.size(); idx++)
            {
-              scanang[idx] = start + static_cast<float>(fovn[idx]-1) * step;
+              scanang[idx] = start + static_cast<float>(fovnData[idx] - 1) * step;
            }
         }
 
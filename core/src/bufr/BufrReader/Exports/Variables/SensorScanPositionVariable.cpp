@@ -4,6 +4,7 @@
 
 #include <time.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <memory>
@@ -55,27 +56,24 @@ namespace bufr {
         }
 
         // Read the variables from the map
-        auto& fovnObj = map.at(getExportKey(ConfKeys::FieldOfViewNumber));
+        const auto fovn = column<int>(map, getExportKey(ConfKeys::FieldOfViewNumber));
+        const auto& fovnObj = fovn.object();
+        const int* fovnData = fovn.data();
 
         // Declare and initialize scanline array
         // scanline has the same dimension as fovn
-        std::vector<int> scanpos(fovnObj->size(), DataObject<float>::missingValue());
+        std::vector<int> scanpos(fovn.size(), DataObject<int>::missingValue());
 
-        // Get field-of-view number
-        std::vector<int> fovn(fovnObj->size(), DataObject<int>::missingValue());
         if (sensor == "iasi")
         {
-           for (size_t idx = 0; idx < fovnObj->size(); idx++)
+           for (size_t idx = 0; idx < fovn.size(); idx++)
            {
-              scanpos[idx] = static_cast<float>((fovnObj->getAsInt(idx) - 1) / 2 + 1);
+              scanpos[idx] = (fovnData[idx] - 1) / 2 + 1;
            }
         }
         else
         {
-           for (size_t idx = 0; idx < fovnObj->size(); idx++)
-           {
-              scanpos[idx] = static_cast<float>(fovnObj->getAsInt(idx));
-           }
+           std::copy(fovnData, fovnData + fovn.size(), scanpos.begin());
         }
 
         return DataObjectBuilder::make<int>(scanpos,
@@ -4,6 +4,7 @@
 
 #include <time.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <memory>
@@ -48,37 +49,95 @@ namespace bufr {
         checkKeys(map);
 
         // Read the variables from the map
-        auto& radObj = map.at(getExportKey(ConfKeys::ScaledSpectralRadiance));
-        auto& sensorChanObj = map.at(getExportKey(ConfKeys::SensorChannelNumber));
-        auto& startChanObj = map.at(getExportKey(ConfKeys::StartChannel));
-        auto& endChanObj = map.at(getExportKey(ConfKeys::EndChannel));
-        auto& scaleFactorObj = map.at(getExportKey(ConfKeys::ScaleFactor));
+        const auto rad = column<float>(map, getExportKey(ConfKeys::ScaledSpectralRadiance));
+        const auto sensorChan = column<int>(map, getExportKey(ConfKeys::SensorChannelNumber));
+        const auto startChan = column<int>(map, getExportKey(ConfKeys::StartChannel));
+        const auto endChan = column<int>(map, getExportKey(ConfKeys::EndChannel));
+        const auto scaleFactors = column<float>(map, getExportKey(ConfKeys::ScaleFactor));
+        const auto& radObj = rad.object();
 
         // Declare unscale spectral radiance data array from scaled spectral radiance
-        std::vector<float> outData((radObj->size()), DataObject<float>::missingValue());
+        const float missing = DataObject<float>::missingValue();
+        std::vector<float> outData((rad.size()), missing);
 
         // Get dimensions
-        size_t nchns = (radObj->getDims())[1];
-        size_t nbands = (startChanObj->getDims())[1];
-
-        // Convert the scaled radiance to unscaled radiance
-        for (size_t idx = 0; idx < radObj->size(); idx++)
+        const size_t nchns = (radObj->getDims())[1];
+        const size_t nbands = (startChan.object()->getDims())[1];
+        const size_t nlocs = (nchns > 0 && nbands > 0) ? rad.size() / nchns : 0;
+
+        const float* radData = rad.data();
+        const char* radValid = rad.validity();
+        const int* chanData = sensorChan.data();
+        const int* startData = startChan.data();
+        const int* endData = endChan.data();
+        const float* scaleData = scaleFactors.data();
+        const char* scaleValid = scaleFactors.validity();
+
+        // Convert the scaled radiance to unscaled radiance (each location independently)
+        #pragma omp parallel
         {
-            auto channel = sensorChanObj->getAsInt(idx);
-            size_t iloc = static_cast<size_t>(floor(idx / nchns));
-            size_t bandOffset;
-
-            for (size_t ibnd = 0; ibnd < nbands; ibnd++)
-            {
-                bandOffset = iloc * nbands + ibnd;
-               if (channel >= startChanObj->getAsInt(bandOffset) &&
-                   channel <= endChanObj->getAsInt(bandOffset)) break;
-            }
-
-            if (!radObj->isMissing(idx) && !scaleFactorObj->isMissing(bandOffset))
+            std::vector<size_t> chanBands(nchns);
+            std::vector<float> chanScales(nchns);
+            std::vector<char> chanValid(nchns);
+            std::vector<float> bandScales(nbands);
+            std::vector<char> bandValid(nbands);
+            const int* prevChans = nullptr;
+            const int* prevStarts = nullptr;
+            const int* prevEnds = nullptr;
+
+            #pragma omp for schedule(static)
+            for (size_t iloc = 0; iloc < nlocs; iloc++)
             {
-                auto scaleFactor = powf(10.0f, -(scaleFactorObj->getAsFloat(bandOffset) ));
-                outData[idx] = radObj->getAsFloat(idx) * scaleFactor;
+                const int* chans = chanData + iloc * nchns;
+                const int* starts = startData + iloc * nbands;
+                const int* ends = endData + iloc * nbands;
+
+                // Map each channel to its band. The channels and band ranges are usually the
+                // same for every location, so the map of the previous location is reused when
+                // they are.
+                if (!(prevChans && std::equal(chans, chans + nchns, prevChans) &&
+                      std::equal(starts, starts + nbands, prevStarts) &&
+                      std::equal(ends, ends + nbands, prevEnds)))
+                {
+                    for (size_t ichn = 0; ichn < nchns; ichn++)
+                    {
+                        size_t ibnd = 0;
+                        while (ibnd < nbands - 1 &&
+                               !(chans[ichn] >= starts[ibnd] && chans[ichn] <= ends[ibnd]))
+                        {
+                            ibnd++;
+                        }
+
+                        chanBands[ichn] = ibnd;
+                    }
+                }
+
+                prevChans = chans;
+                prevStarts = starts;
+                prevEnds = ends;
+
+                // Compute 10^-scale once per band
+                for (size_t ibnd = 0; ibnd < nbands; ibnd++)
+                {
+                    bandValid[ibnd] = scaleValid[iloc * nbands + ibnd];
+                    bandScales[ibnd] = powf(10.0f, -scaleData[iloc * nbands + ibnd]);
+                }
+
+                for (size_t ichn = 0; ichn < nchns; ichn++)
+                {
+                    chanScales[ichn] = bandScales[chanBands[ichn]];
+                    chanValid[ichn] = bandValid[chanBands[ichn]];
+                }
+
+                // Unscale all the channels of the location
+                const float* locRad = radData + iloc * nchns;
+                const char* locValid = radValid + iloc * nchns;
+                float* locOut = outData.data() + iloc * nchns;
+                for (size_t ichn = 0; ichn < nchns; ichn++)
+                {
+                    locOut[ichn] = (locValid[ichn] & chanValid[ichn]) ?
+                        locRad[ichn] * chanScales[ichn] : missing;
+                }
             }
         }
 
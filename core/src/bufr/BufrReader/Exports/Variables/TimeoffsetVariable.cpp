@@ -13,6 +13,7 @@
 #include "eckit/exception/Exceptions.h"
 
 #include "bufr/DataObject.h"
+#include "bufr/EpochTime.h"
 #include "Transforms/TransformBuilder.h"
 #include "../../../DataObjectBuilder.h"
 #include "../../../Log.h"
@@ -23,7 +24,6 @@ namespace
     {
         const char* Timeoffset = "timeOffset";
         const char* Referencetime = "referenceTime";
-        const char* Transforms = "transforms";
     }  // namespace ConfKeys
 }  // namespace
 
@@ -32,7 +32,8 @@ namespace bufr {
     TimeoffsetVariable::TimeoffsetVariable(const std::string& exportName,
                                            const std::string& groupByField,
                                            const eckit::LocalConfiguration &conf) :
-      Variable(exportName, groupByField, conf)
+      Variable(exportName, groupByField, conf),
+      transform_(TransformBuilder::makeFusedTransform(conf))
     {
         initQueryMap();
     }
@@ -41,16 +42,6 @@ namespace bufr {
     {
         checkKeys(map);
 
-        std::tm tm{};                // zero initialise
-        tm.tm_year = 1970 - 1900;    // 1970
-        tm.tm_mon = 0;               // Jan=0, Feb=1, ...
-        tm.tm_mday = 1;              // 1st
-        tm.tm_hour = 0;              // midnight
-        tm.tm_min = 0;
-        tm.tm_sec = 0;
-        tm.tm_isdst = 0;             // Not daylight saving
-        std::time_t epochDt = timegm(&tm);
-
         // Convert the reference time (ISO8601 string) to time struct
         std::tm ref_time = {};
         std::istringstream ss(conf_.getString(ConfKeys::Referencetime));
@@ -63,29 +54,29 @@ namespace bufr {
             throw eckit::BadParameter(errStr.str());
         }
 
+        const auto refSeconds = secondsSinceEpoch(ref_time.tm_year + 1900,
+                                                  ref_time.tm_mon + 1,
+                                                  ref_time.tm_mday,
+                                                  ref_time.tm_hour,
+                                                  ref_time.tm_min,
+                                                  ref_time.tm_sec);
+
         auto timeOffsets = map.at(getExportKey(ConfKeys::Timeoffset));
-        if (conf_.has(ConfKeys::Transforms))
+        if (transform_)
         {
-            auto transforms = TransformBuilder::makeTransforms(conf_);
-            for (const auto &transform : transforms)
-            {
-                transform->apply(timeOffsets);
-            }
+            transform_->apply(timeOffsets);
         }
 
-        auto timeDiffs = std::vector<int64_t> (timeOffsets->size());
-        for (size_t idx = 0; idx < timeOffsets->size(); ++idx)
-        {
-            auto diff_time = DataObject<int64_t>::missingValue();
-            if (!timeOffsets->isMissing(idx))
-            {
-                auto obs_tm = ref_time;
-                obs_tm.tm_sec = ref_time.tm_sec + timeOffsets->getAsInt(idx);
-                auto thisTime = timegm(&obs_tm);
-                diff_time = static_cast<int64_t>(difftime(thisTime, epochDt));
-            }
+        const auto offsets = Column<int>(timeOffsets);
 
-            timeDiffs[idx] = diff_time;
+        static const auto missingTime = DataObject<int64_t>::missingValue();
+        const int* offsetData = offsets.data();
+        const char* offsetValid = offsets.validity();
+
+        auto timeDiffs = std::vector<int64_t>(offsets.size());
+        for (size_t idx = 0; idx < offsets.size(); ++idx)
+        {
+            timeDiffs[idx] = offsetValid[idx] ? refSeconds + offsetData[idx] : missingTime;
         }
 
         return DataObjectBuilder::make<int64_t>(timeDiffs,
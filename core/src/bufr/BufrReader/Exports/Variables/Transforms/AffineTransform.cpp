@@ -0,0 +1,46 @@
+// (C) Copyright 2020 NOAA/NWS/NCEP/EMC
+
+#include "AffineTransform.h"
+
+#include <cmath>
+
+namespace bufr {
+    AffineTransform::AffineTransform(const Transforms& steps) :
+      steps_(steps)
+    {
+        for (const auto& step : steps_)
+        {
+            double stepScale = 1.0;
+            double stepOffset = 0.0;
+            step->compose(stepScale, stepOffset);
+            integerSteps_ = integerSteps_ &&
+                            std::trunc(stepScale) == stepScale &&
+                            std::trunc(stepOffset) == stepOffset;
+
+            step->compose(scale_, offset_);
+        }
+    }
+
+    void AffineTransform::apply(std::shared_ptr<DataObjectBase>& dataObject)
+    {
+        if (integerSteps_ ||
+            std::dynamic_pointer_cast<DataObject<float>>(dataObject) ||
+            std::dynamic_pointer_cast<DataObject<double>>(dataObject))
+        {
+            dataObject->scaleAndOffset(scale_, offset_);
+        }
+        else
+        {
+            for (const auto& step : steps_)
+            {
+                step->apply(dataObject);
+            }
+        }
+    }
+
+    void AffineTransform::compose(double& scale, double& offset) const
+    {
+        scale *= scale_;
+        offset = offset * scale_ + offset_;
+    }
+}  // namespace bufr
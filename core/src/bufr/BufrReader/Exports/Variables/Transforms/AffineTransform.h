@@ -0,0 +1,38 @@
+// (C) Copyright 2020 NOAA/NWS/NCEP/EMC
+
+#pragma once
+
+#include "Transform.h"
+
+
+namespace bufr {
+    /// \brief Transforms data by scaling it and then adding an offset (scale * x + offset) in a
+    ///        single pass. Used to apply a whole chain of scale and offset transforms at once.
+    ///        Integer fields truncate after every step, so for them the chain is only folded
+    ///        when every step is an integer (otherwise the steps are applied one at a time).
+    class AffineTransform : public Transform
+    {
+     public:
+        /// \brief Constructor
+        /// \param steps The chain of transforms to fold together.
+        explicit AffineTransform(const Transforms& steps);
+        ~AffineTransform() = default;
+
+        /// \brief Modify data according to the rules of the transform.
+        /// \param array Array of data to modify.
+        void apply(std::shared_ptr<DataObjectBase>& dataObject) override;
+
+        /// \brief Fold this transform into the affine map x -> scale * x + offset.
+        /// \param scale The scale of the map (updated).
+        /// \param offset The offset of the map (updated).
+        void compose(double& scale, double& offset) const override;
+
+     private:
+        const Transforms steps_;
+        double scale_ = 1.0;
+        double offset_ = 0.0;
+
+        /// \brief Does every step scale or offset by an integer.
+        bool integerSteps_ = true;
+    };
+}  // namespace bufr
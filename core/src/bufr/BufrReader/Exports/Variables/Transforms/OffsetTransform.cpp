@@ -15,4 +15,9 @@ namespace bufr {
         dataObject->offsetBy(offset_);
     }
 
+    void OffsetTransform::compose(double& scale, double& offset) const
+    {
+        offset += offset_;
+    }
+
 }  // namespace bufr
@@ -12,4 +12,10 @@ namespace bufr {
     {
         dataObject->multiplyBy(scaling_);
     }
+
+    void ScalingTransform::compose(double& scale, double& offset) const
+    {
+        scale *= scaling_;
+        offset *= scaling_;
+    }
 }  // namespace bufr
@@ -19,6 +19,11 @@ namespace bufr {
         /// \param array Array of data to modify.
         void apply(std::shared_ptr<DataObjectBase>& dataObject) override;
 
+        /// \brief Fold this transform into the affine map x -> scale * x + offset.
+        /// \param scale The scale of the map (updated).
+        /// \param offset The offset of the map (updated).
+        void compose(double& scale, double& offset) const override;
+
      private:
         const double scaling_;
     };
@@ -17,6 +17,12 @@ namespace bufr {
         /// \brief Modify data according to the rules of the transform.
         /// \param array Array of data to modify.
         virtual void apply(std::shared_ptr<DataObjectBase>& dataObject) = 0;
+
+        /// \brief Fold this transform into the affine map x -> scale * x + offset so that a
+        ///        chain of transforms can be applied in a single pass.
+        /// \param scale The scale of the map (updated).
+        /// \param offset The offset of the map (updated).
+        virtual void compose(double& scale, double& offset) const = 0;
     };
 
     typedef std::vector <std::shared_ptr<Transform>> Transforms;
@@ -4,6 +4,7 @@
 
 #include "eckit/exception/Exceptions.h"
 
+#include "AffineTransform.h"
 #include "ScalingTransform.h"
 #include "OffsetTransform.h"
 
@@ -46,4 +47,16 @@ namespace bufr {
 
         return transforms;
     }
+
+    std::shared_ptr<Transform> TransformBuilder::makeFusedTransform(
+        const eckit::Configuration& conf)
+    {
+        const auto transforms = makeTransforms(conf);
+        if (transforms.empty())
+        {
+            return nullptr;
+        }
+
+        return std::make_shared<AffineTransform>(transforms);
+    }
 }  // namespace bufr
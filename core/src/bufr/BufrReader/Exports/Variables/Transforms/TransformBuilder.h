@@ -22,5 +22,11 @@ namespace bufr {
         /// \brief Create a transforms for the config data given.
         /// \param conf ECKit config data for the list of transforms.
         static Transforms makeTransforms(const eckit::Configuration& conf);
+
+        /// \brief Create a single transform equivalent to the whole list of transforms in the
+        ///        config data, so the data only needs to be traversed once.
+        /// \param conf ECKit config data for the list of transforms.
+        /// \return The fused transform, or nullptr if there are no transforms.
+        static std::shared_ptr<Transform> makeFusedTransform(const eckit::Configuration& conf);
     };
 }  // namespace bufr
@@ -254,7 +254,9 @@ CONTAINS
     end do 
 301 format(i6,2x,i6,2x,22(f8.3))
 
-    ! Do FFT transform
+    ! Do FFT transform (each channel is an independent image, so they are
+    ! remapped in parallel)
+!$omp parallel do default(shared) private(ichan, iscan, ifov, i, ios) schedule(dynamic)
     DO ichan = 1, nchanl
 
        err(ichan) = 0
@@ -292,6 +294,7 @@ CONTAINS
           end if
        enddo
     enddo 
+!$omp end parallel do
 
     do ichan = 1,nchanl
       if(err(ichan) >= 1)then
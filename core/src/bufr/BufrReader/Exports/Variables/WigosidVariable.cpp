@@ -47,53 +47,63 @@ namespace bufr {
     std::shared_ptr<DataObjectBase> WigosidVariable::exportData(const BufrDataMap& map)
     {
         checkKeys(map);
-        static const int missingInt = DataObject<int>::missingValue();
 
-        std::vector<std::string> wigosID;
-        wigosID.reserve(map.at(getExportKey(ConfKeys::Wgosids))->size());
+        const auto wgosids = column<int>(map, getExportKey(ConfKeys::Wgosids));
+        const auto wgosisid = column<int>(map, getExportKey(ConfKeys::Wgosisid));
+        const auto wgosisnm = column<int>(map, getExportKey(ConfKeys::Wgosisnm));
+        const auto& wgoslidVar = map.at(getExportKey(ConfKeys::Wgoslid));
 
-        auto wgosidsVar = map.at(getExportKey(ConfKeys:: Wgosids));
+        // WIGOS ids repeat for every observation from a station, so store them dictionary
+        // encoded (codes plus unique values).
+        static const int missingCode = DataObject<std::string>::missingCode();
+        std::vector<int> codes(wgosids.size(), missingCode);
+        std::vector<std::string> dictionary;
+        std::unordered_map<std::string, int> lookup;
+
+        const auto& wigosIds = wgosids.object();
 
         // Validation
-        if (!wgosidsVar->hasSamePath(map.at(getExportKey(ConfKeys::Wgosisid))) ||
-            !wgosidsVar->hasSamePath(map.at(getExportKey(ConfKeys::Wgosisnm))) ||
-            !wgosidsVar->hasSamePath(map.at(getExportKey(ConfKeys::Wgoslid))))
+        if (!wigosIds->hasSamePath(wgosisid.object()) ||
+            !wigosIds->hasSamePath(wgosisnm.object()) ||
+            !wigosIds->hasSamePath(wgoslidVar))
         {
             std::ostringstream errStr;
             errStr << "Wigosid variables are not all from the same path.";
             throw eckit::BadParameter(errStr.str());
         }
 
-        for (unsigned int idx = 0; idx < map.at(getExportKey(ConfKeys::Wgosids))->size(); idx++)
+        for (size_t idx = 0; idx < wgosids.size(); idx++)
         {
-            auto wgosids = map.at(getExportKey(ConfKeys::Wgosids))->getAsInt(idx);
-            auto wgosisid = map.at(getExportKey(ConfKeys::Wgosisid))->getAsInt(idx);
-            auto wgosisnm = map.at(getExportKey(ConfKeys::Wgosisnm))->getAsInt(idx);
-            auto wgoslid = map.at(getExportKey(ConfKeys::Wgoslid))->getAsString(idx);
+            if (!(wgosids.isValid(idx) && wgosisid.isValid(idx) && wgosisnm.isValid(idx)))
+            {
+                continue;
+            }
+
+            auto wgoslid = wgoslidVar->getAsString(idx);
+            if (wgoslid == "") continue;
 
             std::stringstream wgosAll;
-            if (wgosids != missingInt &&
-                wgosisid != missingInt &&
-                wgosisnm != missingInt &&
-                wgoslid != "")
+            wgosAll << wgosids[idx] <<  "-";
+            wgosAll << wgosisid[idx] <<  "-";
+            wgosAll << wgosisnm[idx] <<  "-";
+            wgosAll << wgoslid;
+
+            auto result = lookup.emplace(wgosAll.str(), static_cast<int>(dictionary.size()));
+            if (result.second)
             {
-                wgosAll << wgosids <<  "-";
-                wgosAll << wgosisid <<  "-";
-                wgosAll << wgosisnm <<  "-";
-                wgosAll << wgoslid;
-                // std::cout << "WGOSID: "  <<  wgosAll.str() << std::endl;
+                dictionary.push_back(wgosAll.str());
             }
-            wigosID.push_back(wgosAll.str());
-        }
 
-        const auto& wigosIds = map.at(getExportKey(ConfKeys::Wgosids));
+            codes[idx] = result.first->second;
+        }
 
-        return DataObjectBuilder::make<std::string>(wigosID,
-                                                    getExportName(),
-                                                    groupByField_,
-                                                    wigosIds->getDims(),
-                                                    wigosIds->getPath(),
-                                                    wigosIds->getDimPaths());
+        return DataObjectBuilder::makeDictionary(codes,
+                                                 dictionary,
+                                                 getExportName(),
+                                                 groupByField_,
+                                                 wigosIds->getDims(),
+                                                 wigosIds->getPath(),
+                                                 wigosIds->getDimPaths());
     }
 
     void WigosidVariable::checkKeys(const BufrDataMap& map)
@@ -16,6 +16,7 @@ namespace bufr {
     QueryRunner::QueryRunner(const QuerySet& querySet, ResultSet& resultSet,
                              const DataProviderType &dataProvider) :
         querySet_(querySet),
+        predicates_(querySet.predicates()),
         resultSet_(resultSet),
         dataProvider_(dataProvider)
     {
@@ -23,7 +24,73 @@ namespace bufr {
 
     void QueryRunner::accumulate()
     {
-      resultSet_.impl_->frames_.push_back(SubsetLookupTable(dataProvider_, getTargets()));
+      const auto targets = getTargets();
+      const auto predicateTargets = findPredicateTargets(*targets);
+
+      // Keep the targets even if every subset gets rejected so the ResultSet can still describe
+      // the (empty) fields.
+      resultSet_.impl_->targets_ = targets;
+
+      if (predicateTargets.empty())
+      {
+        resultSet_.impl_->frames_.push_back(SubsetLookupTable(dataProvider_, targets));
+        return;
+      }
+
+      // Only collect what the predicates test, so rejected subsets never collect the rest.
+      std::vector<size_t> targetIdxs;
+      for (const auto& predicateTarget : predicateTargets)
+      {
+        targetIdxs.push_back(predicateTarget.second);
+      }
+
+      auto frame = SubsetLookupTable(dataProvider_, targets, targetIdxs);
+      if (passesPredicates(frame, predicateTargets))
+      {
+        frame.addRemainingTargets(dataProvider_);
+        resultSet_.impl_->frames_.push_back(std::move(frame));
+      }
+    }
+
+    std::vector<std::pair<size_t, size_t>>
+    QueryRunner::findPredicateTargets(const Targets& targets) const
+    {
+        std::vector<std::pair<size_t, size_t>> predicateTargets;
+        for (size_t predIdx = 0; predIdx < predicates_.size(); ++predIdx)
+        {
+            for (size_t targetIdx = 0; targetIdx < targets.size(); ++targetIdx)
+            {
+                const auto& target = targets[targetIdx];
+                if (target->name != predicates_[predIdx].first) continue;
+
+                // Filtered queries only use some of the node's values so they can't be tested
+                // here.
+                if (target->nodeIdx != 0 && !target->usesFilters)
+                {
+                    predicateTargets.push_back({predIdx, targetIdx});
+                }
+
+                break;
+            }
+        }
+
+        return predicateTargets;
+    }
+
+    bool QueryRunner::passesPredicates(
+        const SubsetLookupTable& frame,
+        const std::vector<std::pair<size_t, size_t>>& predicateTargets) const
+    {
+        for (const auto& predicateTarget : predicateTargets)
+        {
+            const auto& target = frame.targetAtIdx(predicateTarget.second);
+            if (!predicates_[predicateTarget.first].second(frame[target->nodeIdx].data))
+            {
+                return false;
+            }
+        }
+
+        return true;
     }
 
     std::shared_ptr<Targets> QueryRunner::getTargets()
@@ -5,12 +5,14 @@
 #include <array>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "bufr/DataProvider.h"
 #include "bufr/SubsetVariant.h"
 #include "bufr/QuerySet.h"
 #include "bufr/ResultSet.h"
+#include "SubsetLookupTable.h"
 #include "Target.h"
 
 namespace bufr {
@@ -26,11 +28,12 @@ namespace bufr {
                     const DataProviderType& dataProvider);
 
         /// \brief Run the queries against the currently open BUFR message subset. Collect the
-        /// results into the ResultSet.
+        /// results into the ResultSet (unless the subset fails one of the QuerySet predicates).
         void accumulate();
 
      private:
         const QuerySet querySet_;
+        const SubsetPredicates predicates_;
         ResultSet& resultSet_;
         const DataProviderType& dataProvider_;
 
@@ -40,5 +43,17 @@ namespace bufr {
         /// apply to the QuerySet and cache them.
         /// \param[in, out] targets The list of targets to populate.
         std::shared_ptr<Targets> getTargets();
+
+        /// \brief Find the targets the QuerySet predicates can be tested on.
+        /// \param[in] targets The targets of the current subset.
+        /// \return The (predicate idx, target idx) pairs of the predicates that can be tested.
+        std::vector<std::pair<size_t, size_t>> findPredicateTargets(const Targets& targets) const;
+
+        /// \brief Check the collected data for a subset against the QuerySet predicates.
+        /// \param[in] frame The data collected for the subset.
+        /// \param[in] predicateTargets The predicates to test and their targets.
+        /// \return False if any predicate rejects the subset.
+        bool passesPredicates(const SubsetLookupTable& frame,
+                              const std::vector<std::pair<size_t, size_t>>& predicateTargets) const;
     };
 }  // namespace bufr
@@ -52,4 +52,14 @@ namespace bufr {
   {
     return impl_->queriesFor(name);
   }
+
+  void QuerySet::addPredicate(const std::string& name, const SubsetPredicate& predicate)
+  {
+    impl_->addPredicate(name, predicate);
+  }
+
+  SubsetPredicates QuerySet::predicates() const
+  {
+    return impl_->predicates();
+  }
 }  // namespace bufr
@@ -9,6 +9,7 @@
 #include <map>
 
 #include "bufr/QueryParser.h"
+#include "bufr/QuerySet.h"
 
 namespace bufr {
     typedef std::set<std::string> Subsets;
@@ -43,11 +44,23 @@ namespace bufr {
         /// \return A vector of queries.
         std::vector<Query> queriesFor(const std::string& name) const;
 
+        /// \brief Only keep subsets whose values for the named query pass the predicate.
+        /// \param[in] name The name of the query the predicate tests.
+        /// \param[in] predicate The predicate.
+        void addPredicate(const std::string& name, const SubsetPredicate& predicate)
+        {
+            predicates_.push_back({name, predicate});
+        }
+
+        /// \brief Returns the predicates subsets must pass.
+        const SubsetPredicates& predicates() const { return predicates_; }
+
      private:
         std::unordered_map<std::string, std::vector<Query>> queryMap_;
         bool includesAllSubsets_;
         bool addHasBeenCalled_;
         const Subsets limitSubsets_;
         Subsets presentSubsets_;
+        SubsetPredicates predicates_;
     };
 }  // namespace bufr
@@ -19,7 +19,7 @@ namespace bufr {
                                                      const std::string& overrideType) const
 {
     // Make sure we have accumulated frames otherwise something is wrong.
-    if (frames_.size() == 0)
+    if (frames_.size() == 0 && targets_ == nullptr)
     {
       throw eckit::BadValue("ResultSet has no data.");
     }
@@ -47,9 +47,24 @@ namespace bufr {
 
   details::TargetMetaDataPtr ResultSetImpl::analyzeTarget(const std::string& name) const {
     auto metaData       = std::make_shared<details::TargetMetaData>();
-    metaData->targetIdx = frames_.front().getTargetIdx(name);
     metaData->missingFrames.resize(frames_.size(), false);
 
+    // Every subset was rejected, so there are no rows and the targets describe the field.
+    if (frames_.empty()) {
+      const auto& target = findTarget(name);
+      metaData->typeInfo = target->typeInfo;
+      metaData->dims.resize(std::max<size_t>(target->exportDimIdxs.size(), 1), 1);
+      metaData->dims[0]  = 0;
+      metaData->dimPaths = target->dimPaths;
+      if (metaData->dimPaths.empty()) {
+        metaData->dimPaths = {Query()};
+      }
+
+      return metaData;
+    }
+
+    metaData->targetIdx = frames_.front().getTargetIdx(name);
+
     // Loop through the frames to determine the overall parameters for the result data. We will
     // want to find the dimension information and determine if the array could be jagged which
     // means we will need to do extra work later (otherwise we can quickly copy the data).
@@ -408,11 +423,21 @@ namespace bufr {
   }
 
   std::string ResultSetImpl::unit(const std::string& fieldName) const {
+    if (frames_.empty()) return findTarget(fieldName)->typeInfo.unit;
+
     const auto targetIdx = frames_.front().getTargetIdx(fieldName);
     const auto& target   = frames_.front().targetAtIdx(targetIdx);
     return target->typeInfo.unit;
   }
 
+  const TargetPtr& ResultSetImpl::findTarget(const std::string& name) const {
+    for (const auto& target : *targets_) {
+      if (target->name == name) return target;
+    }
+
+    throw eckit::BadParameter("ResultSet has no field named " + name + ".");
+  }
+
   std::shared_ptr<DataObjectBase> ResultSetImpl::makeDataObject(
     const std::string& fieldName, const std::string& groupByFieldName, const TypeInfo& info,
     const std::string& overrideType, const Data& data, const std::vector<int>& dims,
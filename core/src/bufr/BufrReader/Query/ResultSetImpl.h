@@ -80,6 +80,10 @@ namespace details
      private:
         Frames frames_;
 
+        /// \brief The targets of the last subset read. Describes the fields when the predicates
+        ///        rejected every subset.
+        std::shared_ptr<Targets> targets_;
+
         /// \brief Computes and returns metadata associated with a target.
         /// \param name The name of the target to get the metadata for.
         /// \return A TargetMetaData object containing the metadata.
@@ -159,6 +163,11 @@ namespace details
         /// \param fieldName The name of the field.
         std::string unit(const std::string& fieldName) const;
 
+        /// \brief Find the target with the given name in targets_.
+        /// \param name The name of the target.
+        /// \return The target. Throws an exception if there is none with that name.
+        const TargetPtr& findTarget(const std::string& name) const;
+
         /// \brief Make an appropriate DataObject for the data considering all the META data
         /// \param fieldName The name of the field to get the data for.
         /// \param groupByFieldName The name of the field to group the data by.
@@ -2,6 +2,9 @@
 
 #include "SubsetLookupTable.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "VectorMath.h"
 #include "bufr/SubsetTable.h"
 
@@ -10,30 +13,67 @@ namespace bufr {
     SubsetLookupTable::SubsetLookupTable(const std::shared_ptr<DataProvider>& dataProvider,
                                          const std::shared_ptr<Targets>& targets) :
         targets_(targets),
-        lookupTable_(makeLookupTable(dataProvider, *targets))
+        lookupTable_(dataProvider->getInode(), dataProvider->getIsc(dataProvider->getInode())),
+        collected_(targets->size(), false)
+    {
+        std::vector<size_t> targetIdxs(targets->size());
+        std::iota(targetIdxs.begin(), targetIdxs.end(), 0);
+        collect(dataProvider, targetIdxs);
+    }
+
+    SubsetLookupTable::SubsetLookupTable(const std::shared_ptr<DataProvider>& dataProvider,
+                                         const std::shared_ptr<Targets>& targets,
+                                         const std::vector<size_t>& targetIdxs) :
+        targets_(targets),
+        lookupTable_(dataProvider->getInode(), dataProvider->getIsc(dataProvider->getInode())),
+        collected_(targets->size(), false)
+    {
+        collect(dataProvider, targetIdxs);
+    }
+
+    void SubsetLookupTable::addRemainingTargets(const std::shared_ptr<DataProvider>& dataProvider)
     {
+        std::vector<size_t> targetIdxs;
+        for (size_t idx = 0; idx < collected_.size(); ++idx)
+        {
+            if (!collected_[idx]) targetIdxs.push_back(idx);
+        }
+
+        collect(dataProvider, targetIdxs);
     }
 
-    SubsetLookupTable::LookupTable
-    SubsetLookupTable::makeLookupTable(const std::shared_ptr<DataProvider>& dataProvider,
-                                       const Targets& targets) const
+    void SubsetLookupTable::collect(const std::shared_ptr<DataProvider>& dataProvider,
+                                    const std::vector<size_t>& targetIdxs)
     {
-        auto lookupTable = LookupTable(dataProvider->getInode(),
-                                       dataProvider->getIsc(dataProvider->getInode()));
+        Targets collectedTargets;
+        for (size_t idx = 0; idx < targets_->size(); ++idx)
+        {
+            if (collected_[idx]) collectedTargets.push_back(targets_->at(idx));
+        }
+
+        Targets newTargets;
+        for (const auto idx : targetIdxs)
+        {
+            if (collected_[idx]) continue;
+
+            newTargets.push_back(targets_->at(idx));
+            collected_[idx] = true;
+        }
+
+        if (newTargets.empty()) return;
 
         auto lookupMetaTable = LookupMetaTable(dataProvider->getInode(),
                                                dataProvider->getIsc(dataProvider->getInode()));
 
         // Populate the lookup table with the counts and data corresponding to each BUFR node
         // we care about.
-        addCounts(dataProvider, targets, lookupTable, lookupMetaTable);
-        addData(dataProvider, targets, lookupTable, lookupMetaTable);
-
-        return lookupTable;
+        addCounts(dataProvider, newTargets, collectedTargets, lookupTable_, lookupMetaTable);
+        addData(dataProvider, newTargets, collectedTargets, lookupTable_, lookupMetaTable);
     }
 
     void SubsetLookupTable::addCounts(const std::shared_ptr<DataProvider>& dataProvider,
                                       const Targets &targets,
+                                      const Targets &collectedTargets,
                                       LookupTable& lookup,
                                       LookupMetaTable& lookupMeta) const
     {
@@ -51,6 +91,18 @@ namespace bufr {
             }
         }
 
+        // The containers of targets collected earlier already have their counts.
+        for (const auto& target : collectedTargets)
+        {
+            for (const auto& path : target->path)
+            {
+                if (path.isContainer())
+                {
+                    lookupMeta[path.nodeId].collectedCounts = false;
+                }
+            }
+        }
+
         // Collect all the counts for the nodes that were flagged from the BUFR subset data section.
         for (size_t cursor = 1; cursor <= dataProvider->getNVal(); ++cursor)
         {
@@ -80,13 +132,22 @@ namespace bufr {
 
     void SubsetLookupTable::addData(const std::shared_ptr<DataProvider>& dataProvider,
                                     const Targets &targets,
+                                    const Targets &collectedTargets,
                                     LookupTable& lookup,
                                     LookupMetaTable& lookupMeta) const
     {
-        // Reserve space for the data in the lookup table by summing the counts for each node.
+        // Reserve space for the data in the lookup table by summing the counts for each node
+        // (skipping the nodes of targets collected earlier, which already have their data).
         for (const auto& target : targets)
         {
             if (target->nodeIdx == 0) { continue; }
+            if (std::any_of(collectedTargets.begin(), collectedTargets.end(),
+                            [&target](const auto& collectedTarget)
+                            { return collectedTarget->nodeIdx == target->nodeIdx; }))
+            {
+                continue;
+            }
+
             const auto &path = target->path.back();
 
             lookup[target->nodeIdx].data.isLongStr(target->typeInfo.isLongString());
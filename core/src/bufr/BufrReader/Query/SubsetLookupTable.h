@@ -67,6 +67,17 @@ namespace bufr {
         SubsetLookupTable(const std::shared_ptr<DataProvider>& dataProvider,
                           const std::shared_ptr<Targets>& targets);
 
+        /// \brief Constructor that only collects the data for some of the targets (the rest can
+        /// be added with addRemainingTargets).
+        /// \param[in] targetIdxs The idxs of the targets to collect.
+        SubsetLookupTable(const std::shared_ptr<DataProvider>& dataProvider,
+                          const std::shared_ptr<Targets>& targets,
+                          const std::vector<size_t>& targetIdxs);
+
+        /// \brief Collect the data for the targets the constructor skipped. The data provider
+        /// must still be on the same subset.
+        void addRemainingTargets(const std::shared_ptr<DataProvider>& dataProvider);
+
         /// \brief Returns the NodeData for a given bufr node.
         /// \param[in] nodeId The id of the node to get the data for.
         /// \return The NodeData for the given node.
@@ -96,25 +107,31 @@ namespace bufr {
         const std::shared_ptr<Targets> targets_;
         LookupTable lookupTable_;
 
-        /// \brief Creates a lookup table that maps node ids to NodeData objects.
-        /// \param[in] targets The targets to create the lookup table for.
-        /// \return The lookup table.
-        LookupTable makeLookupTable(const std::shared_ptr<DataProvider>& dataProvider,
-                                    const Targets& targets) const;
+        /// \brief Which targets have had their data collected.
+        std::vector<bool> collected_;
+
+        /// \brief Collect the data of the given targets into the lookup table.
+        /// \param[in] targetIdxs The idxs of the targets to collect.
+        void collect(const std::shared_ptr<DataProvider>& dataProvider,
+                     const std::vector<size_t>& targetIdxs);
 
         /// \brief Adds the counts data for the given targets to the lookup table.
         /// \param[in] targets The targets to add the counts data for.
+        /// \param[in] collectedTargets Targets whose counts are already in the lookup table.
         /// \param[in, out] lookup The lookup table to add the counts data to.
         void addCounts(const std::shared_ptr<DataProvider>& dataProvider,
                        const Targets& targets,
+                       const Targets& collectedTargets,
                        LookupTable& lookup,
                        LookupMetaTable& lookupMeta) const;
 
         /// \brief Adds the data for the given targets to the lookup table.
         /// \param[in] targets The targets to add the data for.
+        /// \param[in] collectedTargets Targets whose data is already in the lookup table.
         /// \param[in, out] lookup The lookup table to add the data to.
         void addData(const std::shared_ptr<DataProvider>& dataProvider,
                      const Targets& targets,
+                     const Targets& collectedTargets,
                      LookupTable& lookup,
                      LookupMetaTable& lookupMeta) const;
     };
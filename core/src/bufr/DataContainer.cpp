@@ -2,7 +2,12 @@
 
 #include "bufr/DataContainer.h"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
 #include <string>
+#include <sstream>
 #include <ostream>
 
 #include "eckit/exception/Exceptions.h"
@@ -196,6 +201,11 @@ namespace bufr {
   std::vector<std::string> DataContainer::getFieldNames() const
   {
     std::vector<std::string> fieldNames;
+    if (dataSets_.empty())
+    {
+      return fieldNames;
+    }
+
     for (const auto& field : dataSets_.begin()->second)
     {
       fieldNames.push_back(field.first);
@@ -251,4 +261,74 @@ namespace bufr {
       }
     }
   }
+
+  void DataContainer::distributeCategories(const eckit::mpi::Comm& comm)
+  {
+    const auto categories = allSubCategories();
+    const auto fieldNames = getFieldNames();
+
+    // The categories are paired up by index, so every rank must have the same categories (and
+    // fields), not just the same number of them. Compare a hash of them across the ranks.
+    std::ostringstream keyStr;
+    for (const auto& category : categories)
+    {
+      for (const auto& subCategory : category) keyStr << subCategory << '\0';
+      keyStr << '\n';
+    }
+
+    for (const auto& field : fieldNames) keyStr << field << '\0';
+
+    size_t minHash = std::hash<std::string>()(keyStr.str());
+    size_t maxHash = minHash;
+    comm.allReduce(minHash, minHash, eckit::mpi::Operation::MIN);
+    comm.allReduce(maxHash, maxHash, eckit::mpi::Operation::MAX);
+    if (minHash != maxHash)
+    {
+      throw eckit::BadParameter("Can't distribute the categories because the ranks don't have "
+                                "the same categories.");
+    }
+
+    // Global number of rows in each category
+    std::vector<size_t> rows(categories.size(), 0);
+    for (size_t catIdx = 0; catIdx < categories.size(); ++catIdx)
+    {
+      if (!fieldNames.empty())
+      {
+        rows[catIdx] = size(categories[catIdx]);
+      }
+    }
+
+    comm.allReduceInPlace(rows.begin(), rows.end(), eckit::mpi::Operation::SUM);
+
+    // Give the biggest categories out first, each to the rank with the fewest rows so far. All
+    // the ranks compute the same owners.
+    std::vector<size_t> order(categories.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&rows](size_t lhs, size_t rhs) { return rows[lhs] > rows[rhs]; });
+
+    std::vector<size_t> owners(categories.size(), 0);
+    std::vector<size_t> rankRows(comm.size(), 0);
+    for (const auto catIdx : order)
+    {
+      const auto rankIt = std::min_element(rankRows.begin(), rankRows.end());
+      owners[catIdx] = static_cast<size_t>(std::distance(rankRows.begin(), rankIt));
+      *rankIt += rows[catIdx];
+    }
+
+    // Gather each category into its owner. The other ranks let go of it right away, so no
+    // rank ever holds more than its own categories and what it parsed.
+    for (size_t catIdx = 0; catIdx < categories.size(); ++catIdx)
+    {
+      for (const auto& field : fieldNames)
+      {
+        get(field, categories[catIdx])->gather(comm, owners[catIdx]);
+      }
+
+      if (owners[catIdx] != comm.rank())
+      {
+        dataSets_.erase(categories[catIdx]);
+      }
+    }
+  }
 }  // namespace bufr
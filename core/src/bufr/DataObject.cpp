@@ -3,8 +3,60 @@
 #include "bufr/DataObject.h"
 #include "bufr/Data.h"
 
+// GCC and Clang can build a function for several instruction sets and pick one at load time.
+#if defined(__x86_64__) && defined(__has_attribute) && !defined(__INTEL_COMPILER)
+  #if __has_attribute(target_clones)
+    #define BUFR_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+  #endif
+#endif
+
+#ifndef BUFR_TARGET_CLONES
+  #define BUFR_TARGET_CLONES
+#endif
+
 namespace bufr {
 
+  BUFR_TARGET_CLONES
+  void convertOctets(const double* src, size_t size, float* dst, uint64_t* validity, float missing)
+  {
+    convertOctets<float>(src, size, dst, validity, missing);
+  }
+
+  BUFR_TARGET_CLONES
+  void convertOctets(const double* src, size_t size, double* dst, uint64_t* validity,
+                     double missing)
+  {
+    convertOctets<double>(src, size, dst, validity, missing);
+  }
+
+  BUFR_TARGET_CLONES
+  void convertOctets(const double* src, size_t size, int32_t* dst, uint64_t* validity,
+                     int32_t missing)
+  {
+    convertOctets<int32_t>(src, size, dst, validity, missing);
+  }
+
+  BUFR_TARGET_CLONES
+  void convertOctets(const double* src, size_t size, uint32_t* dst, uint64_t* validity,
+                     uint32_t missing)
+  {
+    convertOctets<uint32_t>(src, size, dst, validity, missing);
+  }
+
+  BUFR_TARGET_CLONES
+  void convertOctets(const double* src, size_t size, int64_t* dst, uint64_t* validity,
+                     int64_t missing)
+  {
+    convertOctets<int64_t>(src, size, dst, validity, missing);
+  }
+
+  BUFR_TARGET_CLONES
+  void convertOctets(const double* src, size_t size, uint64_t* dst, uint64_t* validity,
+                     uint64_t missing)
+  {
+    convertOctets<uint64_t>(src, size, dst, validity, missing);
+  }
+
   bool DataObjectBase::hasSamePath(const std::shared_ptr<DataObjectBase>& dataObject)
   {
     // Can not be the same
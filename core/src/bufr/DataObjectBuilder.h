@@ -70,6 +70,25 @@ namespace bufr {
       return object;
     }
 
+    static std::shared_ptr<DataObjectBase> makeDictionary(const std::vector<int>& codes,
+                                                          const std::vector<std::string>& dictionary,
+                                                          const std::string& fieldName,
+                                                          const std::string& groupByFieldName,
+                                                          const std::vector<int>& dims,
+                                                          const std::string& query,
+                                                          const std::vector<Query>& dimPaths)
+    {
+      auto object = std::make_shared<DataObject<std::string>>();
+      object->setFieldName(fieldName);
+      object->setData(codes, dictionary);
+      object->setDims(dims);
+      object->setGroupByFieldName(groupByFieldName);
+      object->setDimPaths(dimPaths);
+      object->setQuery(query);
+
+      return object;
+    }
+
   private:
 
     static std::shared_ptr<DataObjectBase> objectByTypeInfo(const TypeInfo& info)
@@ -13,6 +13,8 @@ namespace
     namespace ConfKeys
     {
         const char* OutputPathTemplate = "outputPathTemplate";
+        const char* ChunkBytes = "chunkBytes";
+        const char* ParallelCompression = "parallelCompression";
         const char* Dimensions = "dimensions";
         const char* Variables = "variables";
         const char* Globals = "globals";
@@ -35,6 +37,10 @@ namespace
             const char* Coords = "coordinates";
             const char* Chunks = "chunks";
             const char* CompressionLevel = "compressionLevel";
+            const char* Compressor = "compressor";
+            const char* Quantize = "quantize";
+            const char* SignificantDigits = "significantDigits";
+            const char* Dictionary = "dictionary";
         }  // namespace Variable
 
         namespace Global
@@ -53,6 +59,54 @@ namespace
 
 namespace bufr {
 namespace encoders {
+namespace {
+    /// \brief Check the compressor, compression level and quantization of a variable (the
+    ///        level range depends on the compressor).
+    void checkCompression(const VariableDescription& variable)
+    {
+        if (variable.compressor != "deflate" &&
+            variable.compressor != "zstd" &&
+            variable.compressor != "blosc")
+        {
+            throw eckit::BadParameter("Compressor must be one of deflate, zstd or blosc");
+        }
+
+        if (variable.compressor == "zstd")
+        {
+            if (variable.compressionLevel < 0 || variable.compressionLevel > 22)
+            {
+                throw eckit::BadParameter("Zstd compression level must be a number 0-22");
+            }
+        }
+        else if (variable.compressor == "blosc")
+        {
+            if (variable.compressionLevel < 0 || variable.compressionLevel > 9)
+            {
+                throw eckit::BadParameter("Blosc compression level must be a number 0-9");
+            }
+        }
+        else if (variable.compressionLevel < 0 || variable.compressionLevel > 9)
+        {
+            throw eckit::BadParameter("GZip compression level must be a number 0-9");
+        }
+
+        if (variable.quantize.empty()) return;
+
+        if (variable.quantize != "bitgroom" &&
+            variable.quantize != "granularbr" &&
+            variable.quantize != "bitround")
+        {
+            throw eckit::BadParameter("Quantize must be one of bitgroom, granularbr or bitround");
+        }
+
+        if (variable.significantDigits < 1)
+        {
+            throw eckit::BadParameter(
+                "Quantized variables need a positive number of significantDigits");
+        }
+    }
+}  // namespace
+
     Description::Description(const std::string &yamlFile) : outputPathTemplate_("")
     {
         auto conf = eckit::YAMLConfiguration(eckit::PathName(yamlFile));
@@ -71,6 +125,22 @@ namespace encoders {
             outputPathTemplate_ = conf.getString(ConfKeys::OutputPathTemplate);
         }
 
+        if (conf.has(ConfKeys::ChunkBytes))
+        {
+            int chunkBytes = conf.getInt(ConfKeys::ChunkBytes);
+            if (chunkBytes < 0)
+            {
+                throw eckit::BadParameter("chunkBytes must be 0 or a positive number of bytes");
+            }
+
+            chunkBytes_ = static_cast<size_t>(chunkBytes);
+        }
+
+        if (conf.has(ConfKeys::ParallelCompression))
+        {
+            parallelCompression_ = conf.getBool(ConfKeys::ParallelCompression);
+        }
+
         if (conf.has(ConfKeys::Dimensions))
         {
             auto dimConfs = conf.getSubConfigurations(ConfKeys::Dimensions);
@@ -163,16 +233,36 @@ namespace encoders {
                 variable.chunks = chunks;
             }
 
+            variable.compressor = "deflate";
+            if (varConf.has(ConfKeys::Variable::Compressor))
+            {
+                variable.compressor = varConf.getString(ConfKeys::Variable::Compressor);
+            }
+
             variable.compressionLevel = 6;
             if (varConf.has(ConfKeys::Variable::CompressionLevel))
             {
-                int compressionLevel = varConf.getInt(ConfKeys::Variable::CompressionLevel);
-                if (compressionLevel < 0 || compressionLevel > 9)
+                variable.compressionLevel = varConf.getInt(ConfKeys::Variable::CompressionLevel);
+            }
+
+            variable.quantize = "";
+            variable.significantDigits = 0;
+            if (varConf.has(ConfKeys::Variable::Quantize))
+            {
+                variable.quantize = varConf.getString(ConfKeys::Variable::Quantize);
+                if (varConf.has(ConfKeys::Variable::SignificantDigits))
                 {
-                    throw eckit::BadParameter("GZip compression level must be a number 0-9");
+                    variable.significantDigits =
+                        varConf.getInt(ConfKeys::Variable::SignificantDigits);
                 }
+            }
 
-                variable.compressionLevel = varConf.getInt(ConfKeys::Variable::CompressionLevel);
+            checkCompression(variable);
+
+            variable.dictionary = false;
+            if (varConf.has(ConfKeys::Variable::Dictionary))
+            {
+                variable.dictionary = varConf.getBool(ConfKeys::Variable::Dictionary);
             }
 
             addVariable(variable);
@@ -239,7 +329,8 @@ namespace encoders {
     void Description::py_addVariable(const std::string &name,
                                      const std::string &source,
                                      const std::string &unit,
-                                     const std::string &longName)
+                                     const std::string &longName,
+                                     bool dictionary)
     {
         VariableDescription variable;
         variable.name = name;
@@ -248,9 +339,34 @@ namespace encoders {
         variable.longName = longName;
         variable.compressionLevel = 6;
         variable.chunks = {};
+        variable.dictionary = dictionary;
         addVariable(variable);
     }
 
+    void Description::setCompression(const std::string &name,
+                                     const std::string &compressor,
+                                     int compressionLevel,
+                                     const std::string &quantize,
+                                     int significantDigits)
+    {
+        for (auto &variable : variables_)
+        {
+            if (variable.name != name) continue;
+
+            auto newVariable = variable;
+            newVariable.compressor = compressor;
+            newVariable.compressionLevel = compressionLevel;
+            newVariable.quantize = quantize;
+            newVariable.significantDigits = quantize.empty() ? 0 : significantDigits;
+            checkCompression(newVariable);
+
+            variable = newVariable;
+            return;
+        }
+
+        throw eckit::BadParameter("Unknown variable " + name + ".");
+    }
+
     void Description::addGlobal(const std::shared_ptr<GlobalDescriptionBase> &global)
     {
         globals_.push_back(global);
@@ -0,0 +1,381 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#include "bufr/encoders/arrow/Encoder.h"
+
+#include <bitset>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "bufr/DataObject.h"
+#include "IpcWriter.h"
+
+namespace bufr {
+namespace encoders {
+namespace arrow {
+namespace {
+    /// \brief Buffers made for a column (its numbers are used where they are).
+    struct ColumnBuffers
+    {
+        std::vector<uint8_t> validity;
+        std::vector<int32_t> offsets;
+        std::string chars;
+    };
+
+    template <typename T> ColumnType columnType();
+    template <> ColumnType columnType<int32_t>() { return ColumnType::Int32; }
+    template <> ColumnType columnType<uint32_t>() { return ColumnType::UInt32; }
+    template <> ColumnType columnType<int64_t>() { return ColumnType::Int64; }
+    template <> ColumnType columnType<uint64_t>() { return ColumnType::UInt64; }
+    template <> ColumnType columnType<float>() { return ColumnType::Float32; }
+    template <> ColumnType columnType<double>() { return ColumnType::Float64; }
+
+    /// \brief Count the unset bits among the first numValues bits of a bitmap.
+    size_t countNulls(const std::vector<uint64_t>& bits, size_t numValues)
+    {
+        size_t numValid = 0;
+        for (size_t wordIdx = 0; wordIdx < numValues / 64; ++wordIdx)
+        {
+            numValid += std::bitset<64>(bits[wordIdx]).count();
+        }
+
+        if (numValues % 64 != 0)
+        {
+            const uint64_t mask = (uint64_t(1) << (numValues % 64)) - 1;
+            numValid += std::bitset<64>(bits[numValues / 64] & mask).count();
+        }
+
+        return numValues - numValid;
+    }
+
+    /// \brief Are the bytes of a word stored least significant first (the byte order the IPC
+    ///        writer assumes, and then the words of a validity bitmap have the same bit order as
+    ///        an Arrow bitmap).
+    bool isLittleEndian()
+    {
+        const uint16_t word = 1;
+        return *reinterpret_cast<const uint8_t*>(&word) == 1;
+    }
+
+    /// \brief Point the column at the numbers of the object (no copy). Missing values become
+    ///        nulls (the validity bitmap is only made when the object has none).
+    template <typename T>
+    bool setNumbers(const std::shared_ptr<DataObjectBase>& object,
+                    IpcColumn& column,
+                    ColumnBuffers& buffers)
+    {
+        auto typedObject = std::dynamic_pointer_cast<DataObject<T>>(object);
+        if (!typedObject) return false;
+
+        const auto& data = typedObject->getRawDataRef();
+        column.type = columnType<T>();
+        column.values = data.data();
+        column.valuesBytes = data.size() * sizeof(T);
+
+        if (typedObject->hasValidityBitmap())
+        {
+            const auto& bits = typedObject->getValidityBitmap();
+            column.nullCount = countNulls(bits, data.size());
+
+            // Same bit order as Arrow (least significant bit first) on little endian machines
+            column.validity = reinterpret_cast<const uint8_t*>(bits.data());
+        }
+        else
+        {
+            buffers.validity.assign((data.size() + 7) / 8, 0);
+            for (size_t idx = 0; idx < data.size(); ++idx)
+            {
+                if (data[idx] != DataObject<T>::missingValue())
+                {
+                    buffers.validity[idx / 8] |= static_cast<uint8_t>(1 << (idx % 8));
+                }
+                else
+                {
+                    column.nullCount++;
+                }
+            }
+
+            column.validity = buffers.validity.data();
+        }
+
+        return true;
+    }
+
+    /// \brief Make the offsets and characters of the strings of the object (dictionary encoded
+    ///        strings are written out). Empty (missing) strings become nulls. Unlike the
+    ///        numbers the strings are copied (into the Arrow layout).
+    bool setStrings(const std::shared_ptr<DataObjectBase>& object,
+                    IpcColumn& column,
+                    ColumnBuffers& buffers)
+    {
+        auto typedObject = std::dynamic_pointer_cast<DataObject<std::string>>(object);
+        if (!typedObject) return false;
+
+        const auto strs = typedObject->getRawData();
+
+        size_t numChars = 0;
+        for (const auto& str : strs) numChars += str.size();
+        if (numChars > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+        {
+            throw eckit::BadParameter("The strings of " + column.name + " are too big for an "
+                                      "Arrow string column.");
+        }
+
+        buffers.chars.reserve(numChars);
+        buffers.offsets.reserve(strs.size() + 1);
+        buffers.offsets.push_back(0);
+        buffers.validity.assign((strs.size() + 7) / 8, 0);
+        for (size_t idx = 0; idx < strs.size(); ++idx)
+        {
+            if (strs[idx] != DataObject<std::string>::missingValue())
+            {
+                buffers.validity[idx / 8] |= static_cast<uint8_t>(1 << (idx % 8));
+                buffers.chars += strs[idx];
+            }
+            else
+            {
+                column.nullCount++;
+            }
+
+            buffers.offsets.push_back(static_cast<int32_t>(buffers.chars.size()));
+        }
+
+        column.type = ColumnType::Utf8;
+        column.values = buffers.chars.data();
+        column.valuesBytes = buffers.chars.size();
+        column.offsets = buffers.offsets.data();
+        column.validity = buffers.validity.data();
+        return true;
+    }
+
+    template <typename T>
+    class ArrowGlobalWriter : public GlobalWriter<T>
+    {
+    public:
+      ArrowGlobalWriter() = delete;
+      explicit ArrowGlobalWriter(KeyValues& metadata) : metadata_(metadata) {}
+
+      void write(const std::string& name, const T& data) final
+      {
+        std::ostringstream valueStr;
+        valueStr << data;
+        metadata_.push_back({name, valueStr.str()});
+      }
+
+    private:
+      KeyValues& metadata_;
+    };
+
+    template <typename T>
+    class ArrowGlobalWriter<std::vector<T>> : public GlobalWriter<std::vector<T>>
+    {
+    public:
+      ArrowGlobalWriter() = delete;
+      explicit ArrowGlobalWriter(KeyValues& metadata) : metadata_(metadata) {}
+
+      // The values are separated by commas
+      void write(const std::string& name, const std::vector<T>& data) final
+      {
+        std::ostringstream valueStr;
+        for (size_t idx = 0; idx < data.size(); ++idx)
+        {
+          if (idx > 0) valueStr << ",";
+          valueStr << data[idx];
+        }
+
+        metadata_.push_back({name, valueStr.str()});
+      }
+
+    private:
+      KeyValues& metadata_;
+    };
+}  // namespace
+
+    Encoder::Encoder(const std::string &yamlPath) :
+        description_(Description(yamlPath))
+    {
+    }
+
+    Encoder::Encoder(const Description &description) :
+        description_(description)
+    {
+    }
+
+    Encoder::Encoder(const eckit::Configuration &conf) :
+        description_(Description(conf))
+    {
+    }
+
+    std::map<SubCategory, std::string>
+    Encoder::encode(const std::shared_ptr<DataContainer> &dataContainer,
+                    const std::string &path,
+                    Format format)
+    {
+        std::map<SubCategory, std::string> paths;
+        for (const auto &category : dataContainer->allSubCategories())
+        {
+            const auto filePath = makePath(path, dataContainer, category);
+
+            std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                throw eckit::BadParameter("Could not open " + filePath + " for writing.");
+            }
+
+            encodeCategory(dataContainer, category, format == Format::File,
+                           [&file](const void* data, size_t size)
+                           {
+                               file.write(static_cast<const char*>(data),
+                                          static_cast<std::streamsize>(size));
+                           });
+
+            if (!file.flush())
+            {
+                throw eckit::BadParameter("Failed to write " + filePath + ".");
+            }
+
+            paths[category] = filePath;
+        }
+
+        return paths;
+    }
+
+    std::map<SubCategory, std::vector<uint8_t>>
+    Encoder::encodeToBytes(const std::shared_ptr<DataContainer> &dataContainer, Format format)
+    {
+        std::map<SubCategory, std::vector<uint8_t>> result;
+        for (const auto &category : dataContainer->allSubCategories())
+        {
+            auto& bytes = result[category];
+            encodeCategory(dataContainer, category, format == Format::File,
+                           [&bytes](const void* data, size_t size)
+                           {
+                               const auto* begin = static_cast<const uint8_t*>(data);
+                               bytes.insert(bytes.end(), begin, begin + size);
+                           });
+        }
+
+        return result;
+    }
+
+    void Encoder::encodeCategory(const std::shared_ptr<DataContainer> &dataContainer,
+                                 const SubCategory &category,
+                                 bool isFile,
+                                 const std::function<void(const void*, size_t)> &sink) const
+    {
+        // Everything is written in the machine's byte order but the schema says little endian
+        if (!isLittleEndian())
+        {
+            throw eckit::BadParameter("The Arrow encoder only supports little endian machines.");
+        }
+
+        KeyValues metadata;
+        for (auto &global : description_.getGlobals())
+        {
+            std::shared_ptr<GlobalWriterBase> writer = nullptr;
+            if (std::dynamic_pointer_cast<GlobalDescription<int>>(global))
+            {
+                writer = std::make_shared<ArrowGlobalWriter<int>>(metadata);
+            }
+            else if (std::dynamic_pointer_cast<GlobalDescription<std::vector<int>>>(global))
+            {
+                writer = std::make_shared<ArrowGlobalWriter<std::vector<int>>>(metadata);
+            }
+            else if (std::dynamic_pointer_cast<GlobalDescription<float>>(global))
+            {
+                writer = std::make_shared<ArrowGlobalWriter<float>>(metadata);
+            }
+            else if (std::dynamic_pointer_cast<GlobalDescription<std::vector<float>>>(global))
+            {
+                writer = std::make_shared<ArrowGlobalWriter<std::vector<float>>>(metadata);
+            }
+            else if (std::dynamic_pointer_cast<GlobalDescription<std::string>>(global))
+            {
+                writer = std::make_shared<ArrowGlobalWriter<std::string>>(metadata);
+            }
+
+            if (writer) global->writeTo(writer);
+        }
+
+        // The columns point into these (and into the data objects) until they are written
+        std::vector<std::shared_ptr<DataObjectBase>> objects;
+        std::vector<std::shared_ptr<ColumnBuffers>> allBuffers;
+        std::vector<IpcColumn> columns;
+        for (const auto &varDesc : description_.getVariables())
+        {
+            auto object = dataContainer->get(varDesc.source, category);
+            const auto dims = object->getDims();
+
+            IpcColumn column;
+            column.name = varDesc.name;
+            column.length = dims.empty() ? 0 : static_cast<size_t>(dims[0]);
+            for (size_t dimIdx = 1; dimIdx < dims.size(); ++dimIdx)
+            {
+                column.listSizes.push_back(static_cast<int32_t>(dims[dimIdx]));
+            }
+
+            if (!varDesc.longName.empty())
+            {
+                column.metadata.push_back({"long_name", varDesc.longName});
+            }
+
+            if (!varDesc.units.empty())
+            {
+                column.metadata.push_back({"units", varDesc.units});
+            }
+
+            auto buffers = std::make_shared<ColumnBuffers>();
+            if (!setNumbers<float>(object, column, *buffers) &&
+                !setNumbers<double>(object, column, *buffers) &&
+                !setNumbers<int32_t>(object, column, *buffers) &&
+                !setNumbers<uint32_t>(object, column, *buffers) &&
+                !setNumbers<int64_t>(object, column, *buffers) &&
+                !setNumbers<uint64_t>(object, column, *buffers) &&
+                !setStrings(object, column, *buffers))
+            {
+                throw eckit::BadParameter("The type of " + varDesc.name + " has no Arrow type.");
+            }
+
+            objects.push_back(object);
+            allBuffers.push_back(buffers);
+            columns.push_back(column);
+        }
+
+        writeIpc(columns, metadata, isFile, sink);
+    }
+
+    std::string Encoder::makePath(const std::string &path,
+                                  const std::shared_ptr<DataContainer> &dataContainer,
+                                  const SubCategory &category) const
+    {
+        auto result = path;
+
+        size_t catIdx = 0;
+        for (const auto &catPair : dataContainer->getCategoryMap())
+        {
+            const auto key = "{" + catPair.first + "}";
+            const auto pos = result.find(key);
+            if (pos == std::string::npos)
+            {
+                std::ostringstream errStr;
+                errStr << "Path " << path << " does not contain a substitution for ";
+                errStr << catPair.first << ".";
+                throw eckit::BadParameter(errStr.str());
+            }
+
+            result.replace(pos, key.size(), category.at(catIdx));
+            catIdx++;
+        }
+
+        return result;
+    }
+}  // namespace arrow
+}  // namespace encoders
+}  // namespace bufr
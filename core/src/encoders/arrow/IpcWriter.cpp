@@ -0,0 +1,528 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#include "IpcWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "eckit/exception/Exceptions.h"
+
+namespace
+{
+    // Values from the Arrow format (Schema.fbs and Message.fbs)
+    const int16_t MetadataVersionV5 = 4;
+    const uint8_t HeaderSchema = 1;
+    const uint8_t HeaderRecordBatch = 3;
+    const uint8_t TypeInt = 2;
+    const uint8_t TypeFloatingPoint = 3;
+    const uint8_t TypeUtf8 = 5;
+    const uint8_t TypeFixedSizeList = 16;
+    const int16_t PrecisionSingle = 1;
+    const int16_t PrecisionDouble = 2;
+    const uint32_t Continuation = 0xFFFFFFFF;
+    const char Magic[] = "ARROW1";
+
+    typedef std::vector<uint8_t> Bytes;
+
+    void alignTo(Bytes& buf, size_t alignment)
+    {
+        buf.resize((buf.size() + alignment - 1) / alignment * alignment, 0);
+    }
+
+    template <typename T>
+    void putAt(Bytes& buf, size_t pos, T value)
+    {
+        std::memcpy(buf.data() + pos, &value, sizeof(T));
+    }
+
+    template <typename T>
+    void append(Bytes& buf, T value)
+    {
+        buf.resize(buf.size() + sizeof(T));
+        putAt(buf, buf.size() - sizeof(T), value);
+    }
+
+    /// \brief Point the (unsigned, forward) offset at pos to target.
+    void patchOffset(Bytes& buf, size_t pos, size_t target)
+    {
+        putAt(buf, pos, static_cast<uint32_t>(target - pos));
+    }
+
+    /// \brief Object of a flatbuffer. Objects are written front to back: a table comes after
+    ///        its vtable and before the objects it references, so every (unsigned) offset points
+    ///        forward like the format requires.
+    struct FbObject
+    {
+        virtual ~FbObject() = default;
+
+        /// \brief Write the object at the end of the buffer.
+        /// \return Where offsets to the object point.
+        virtual size_t write(Bytes& buf) const = 0;
+    };
+
+    typedef std::shared_ptr<FbObject> FbRef;
+
+    class FbString : public FbObject
+    {
+     public:
+        explicit FbString(const std::string& str) : str_(str) {}
+
+        size_t write(Bytes& buf) const final
+        {
+            alignTo(buf, 4);
+            const size_t pos = buf.size();
+            append(buf, static_cast<uint32_t>(str_.size()));
+            buf.insert(buf.end(), str_.begin(), str_.end());
+            buf.push_back(0);
+            return pos;
+        }
+
+     private:
+        const std::string str_;
+    };
+
+    /// \brief Vector of structs (FieldNode, Buffer and Block all have 8 byte members).
+    class FbStructVector : public FbObject
+    {
+     public:
+        template <typename T>
+        void add(T value)
+        {
+            append(bytes_, value);
+        }
+
+        void pad(size_t size)
+        {
+            bytes_.resize(bytes_.size() + size, 0);
+        }
+
+        void endStruct()
+        {
+            count_++;
+        }
+
+        size_t write(Bytes& buf) const final
+        {
+            // The elements start on an 8 byte boundary (right after the length)
+            alignTo(buf, 4);
+            if ((buf.size() + 4) % 8 != 0) append(buf, static_cast<uint32_t>(0));
+
+            const size_t pos = buf.size();
+            append(buf, static_cast<uint32_t>(count_));
+            buf.insert(buf.end(), bytes_.begin(), bytes_.end());
+            return pos;
+        }
+
+     private:
+        Bytes bytes_;
+        size_t count_ = 0;
+    };
+
+    /// \brief Vector of tables or strings.
+    class FbRefVector : public FbObject
+    {
+     public:
+        FbRefVector() = default;
+        explicit FbRefVector(const std::vector<FbRef>& items) : items_(items) {}
+
+        size_t write(Bytes& buf) const final
+        {
+            alignTo(buf, 4);
+            const size_t pos = buf.size();
+            append(buf, static_cast<uint32_t>(items_.size()));
+            buf.resize(buf.size() + 4 * items_.size(), 0);
+
+            for (size_t itemIdx = 0; itemIdx < items_.size(); ++itemIdx)
+            {
+                const size_t itemPos = items_[itemIdx]->write(buf);
+                patchOffset(buf, pos + 4 + 4 * itemIdx, itemPos);
+            }
+
+            return pos;
+        }
+
+     private:
+        const std::vector<FbRef> items_;
+    };
+
+    class FbTable : public FbObject
+    {
+     public:
+        template <typename T>
+        FbTable& scalar(int id, T value)
+        {
+            Field field;
+            field.id = id;
+            field.bytes.resize(sizeof(T));
+            std::memcpy(field.bytes.data(), &value, sizeof(T));
+            fields_.push_back(field);
+            return *this;
+        }
+
+        FbTable& ref(int id, const FbRef& object)
+        {
+            Field field;
+            field.id = id;
+            field.bytes.resize(4, 0);
+            field.object = object;
+            fields_.push_back(field);
+            return *this;
+        }
+
+        size_t write(Bytes& buf) const final
+        {
+            // Biggest fields first so they are aligned without padding (the table starts on an
+            // 8 byte boundary and the first 4 bytes are the offset to the vtable)
+            auto fields = fields_;
+            std::stable_sort(fields.begin(), fields.end(), [](const Field& lhs, const Field& rhs)
+                             { return lhs.bytes.size() > rhs.bytes.size(); });
+
+            int numIds = 0;
+            size_t tableSize = 4;
+            std::vector<size_t> fieldOffsets;
+            for (const auto& field : fields)
+            {
+                const size_t size = field.bytes.size();
+                tableSize = (tableSize + size - 1) / size * size;
+                fieldOffsets.push_back(tableSize);
+                tableSize += size;
+                numIds = std::max(numIds, field.id + 1);
+            }
+
+            alignTo(buf, 2);
+            const size_t vtablePos = buf.size();
+            append(buf, static_cast<uint16_t>(4 + 2 * numIds));
+            append(buf, static_cast<uint16_t>(tableSize));
+            buf.resize(buf.size() + 2 * numIds, 0);
+            for (size_t fieldIdx = 0; fieldIdx < fields.size(); ++fieldIdx)
+            {
+                putAt(buf,
+                      vtablePos + 4 + 2 * fields[fieldIdx].id,
+                      static_cast<uint16_t>(fieldOffsets[fieldIdx]));
+            }
+
+            alignTo(buf, 8);
+            const size_t tablePos = buf.size();
+            buf.resize(tablePos + tableSize, 0);
+            putAt(buf, tablePos, static_cast<int32_t>(tablePos - vtablePos));
+            for (size_t fieldIdx = 0; fieldIdx < fields.size(); ++fieldIdx)
+            {
+                const auto& bytes = fields[fieldIdx].bytes;
+                std::memcpy(buf.data() + tablePos + fieldOffsets[fieldIdx],
+                            bytes.data(),
+                            bytes.size());
+            }
+
+            for (size_t fieldIdx = 0; fieldIdx < fields.size(); ++fieldIdx)
+            {
+                if (fields[fieldIdx].object)
+                {
+                    const size_t objectPos = fields[fieldIdx].object->write(buf);
+                    patchOffset(buf, tablePos + fieldOffsets[fieldIdx], objectPos);
+                }
+            }
+
+            return tablePos;
+        }
+
+     private:
+        struct Field
+        {
+            int id = 0;
+            Bytes bytes;
+            FbRef object;
+        };
+
+        std::vector<Field> fields_;
+    };
+
+    std::shared_ptr<FbTable> makeTable()
+    {
+        return std::make_shared<FbTable>();
+    }
+
+    /// \brief Make the flatbuffer with the root table (padded to 8 bytes).
+    Bytes finish(const FbTable& root)
+    {
+        Bytes buf(4, 0);
+        patchOffset(buf, 0, root.write(buf));
+        alignTo(buf, 8);
+        return buf;
+    }
+
+    FbRef makeKeyValues(const bufr::encoders::arrow::KeyValues& keyValues)
+    {
+        std::vector<FbRef> items;
+        for (const auto& keyValue : keyValues)
+        {
+            auto item = makeTable();
+            item->ref(0, std::make_shared<FbString>(keyValue.first));
+            item->ref(1, std::make_shared<FbString>(keyValue.second));
+            items.push_back(item);
+        }
+
+        return std::make_shared<FbRefVector>(items);
+    }
+
+    /// \brief Make the field of the values of a column (the innermost field of a list column).
+    FbRef makeValueField(const std::string& name, bufr::encoders::arrow::ColumnType type)
+    {
+        using bufr::encoders::arrow::ColumnType;
+
+        auto typeTable = makeTable();
+        uint8_t typeId = TypeInt;
+        switch (type)
+        {
+            case ColumnType::Int32:
+                typeTable->scalar(0, int32_t(32)).scalar(1, uint8_t(1));
+                break;
+            case ColumnType::UInt32:
+                typeTable->scalar(0, int32_t(32)).scalar(1, uint8_t(0));
+                break;
+            case ColumnType::Int64:
+                typeTable->scalar(0, int32_t(64)).scalar(1, uint8_t(1));
+                break;
+            case ColumnType::UInt64:
+                typeTable->scalar(0, int32_t(64)).scalar(1, uint8_t(0));
+                break;
+            case ColumnType::Float32:
+                typeId = TypeFloatingPoint;
+                typeTable->scalar(0, PrecisionSingle);
+                break;
+            case ColumnType::Float64:
+                typeId = TypeFloatingPoint;
+                typeTable->scalar(0, PrecisionDouble);
+                break;
+            case ColumnType::Utf8:
+                typeId = TypeUtf8;
+                break;
+        }
+
+        auto field = makeTable();
+        field->ref(0, std::make_shared<FbString>(name))
+              .scalar(1, uint8_t(1))
+              .scalar(2, typeId)
+              .ref(3, typeTable)
+              .ref(5, std::make_shared<FbRefVector>());
+        return field;
+    }
+
+    /// \brief Make the field of a column. Every list size wraps the values in one more fixed
+    ///        size list.
+    FbRef makeField(const bufr::encoders::arrow::IpcColumn& column)
+    {
+        auto field = makeValueField(column.listSizes.empty() ? column.name : "item", column.type);
+        for (size_t listIdx = column.listSizes.size(); listIdx-- > 0;)
+        {
+            auto typeTable = makeTable();
+            typeTable->scalar(0, column.listSizes[listIdx]);
+
+            auto listField = makeTable();
+            listField->ref(0, std::make_shared<FbString>(listIdx == 0 ? column.name : "item"))
+                      .scalar(1, uint8_t(1))
+                      .scalar(2, TypeFixedSizeList)
+                      .ref(3, typeTable)
+                      .ref(5, std::make_shared<FbRefVector>(std::vector<FbRef>{field}));
+            field = listField;
+        }
+
+        if (!column.metadata.empty())
+        {
+            std::static_pointer_cast<FbTable>(field)->ref(6, makeKeyValues(column.metadata));
+        }
+
+        return field;
+    }
+
+    FbRef makeSchema(const std::vector<bufr::encoders::arrow::IpcColumn>& columns,
+                     const bufr::encoders::arrow::KeyValues& metadata)
+    {
+        std::vector<FbRef> fields;
+        for (const auto& column : columns)
+        {
+            fields.push_back(makeField(column));
+        }
+
+        auto schema = makeTable();
+        schema->ref(1, std::make_shared<FbRefVector>(fields));
+        if (!metadata.empty())
+        {
+            schema->ref(2, makeKeyValues(metadata));
+        }
+
+        return schema;
+    }
+
+    Bytes makeMessage(uint8_t headerType, const FbRef& header, int64_t bodyLength)
+    {
+        FbTable message;
+        message.scalar(0, MetadataVersionV5)
+               .scalar(1, headerType)
+               .ref(2, header)
+               .scalar(3, bodyLength);
+        return finish(message);
+    }
+
+    /// \brief A buffer of the record batch body.
+    struct BodyBuffer
+    {
+        const void* data = nullptr;
+        size_t size = 0;
+    };
+
+    size_t padded(size_t size)
+    {
+        return (size + 7) / 8 * 8;
+    }
+
+    /// \brief Counts the bytes on their way to the sink.
+    class CountingSink
+    {
+     public:
+        explicit CountingSink(const bufr::encoders::arrow::IpcSink& sink) : sink_(sink) {}
+
+        void write(const void* data, size_t size)
+        {
+            if (size == 0) return;
+            sink_(data, size);
+            position_ += size;
+        }
+
+        void pad(size_t size)
+        {
+            static const uint8_t Zeros[8] = {0};
+            write(Zeros, size);
+        }
+
+        size_t position() const { return position_; }
+
+     private:
+        const bufr::encoders::arrow::IpcSink& sink_;
+        size_t position_ = 0;
+    };
+
+    /// \brief Write an encapsulated message (continuation, metadata size, metadata, body).
+    /// \return The metadata length (with the prefix) for the footer.
+    int32_t writeMessage(CountingSink& sink, const Bytes& metadata)
+    {
+        const auto size = static_cast<int32_t>(metadata.size());
+        sink.write(&Continuation, sizeof(Continuation));
+        sink.write(&size, sizeof(size));
+        sink.write(metadata.data(), metadata.size());
+        return size + 8;
+    }
+}  // namespace
+
+namespace bufr {
+namespace encoders {
+namespace arrow {
+    void writeIpc(const std::vector<IpcColumn>& columns,
+                  const KeyValues& metadata,
+                  bool isFile,
+                  const IpcSink& sink)
+    {
+        const size_t numRows = columns.empty() ? 0 : columns.front().length;
+
+        // Nodes and buffers of the record batch (the fields in depth first order)
+        auto nodes = std::make_shared<FbStructVector>();
+        auto buffers = std::make_shared<FbStructVector>();
+        std::vector<BodyBuffer> body;
+        size_t bodyLength = 0;
+        auto addBuffer = [&buffers, &body, &bodyLength](const void* data, size_t size)
+        {
+            buffers->add(static_cast<int64_t>(bodyLength));
+            buffers->add(static_cast<int64_t>(size));
+            buffers->endStruct();
+
+            body.push_back({data, size});
+            bodyLength += padded(size);
+        };
+
+        for (const auto& column : columns)
+        {
+            if (column.length != numRows)
+            {
+                throw eckit::BadParameter("Column " + column.name + " doesn't have the same "
+                                          "number of rows as the other columns.");
+            }
+
+            // The lists are never null, only their values can be
+            size_t length = column.length;
+            for (const auto listSize : column.listSizes)
+            {
+                nodes->add(static_cast<int64_t>(length));
+                nodes->add(static_cast<int64_t>(0));
+                nodes->endStruct();
+                addBuffer(nullptr, 0);
+
+                length *= static_cast<size_t>(listSize);
+            }
+
+            const bool hasNulls = column.validity && column.nullCount > 0;
+            nodes->add(static_cast<int64_t>(length));
+            nodes->add(static_cast<int64_t>(hasNulls ? column.nullCount : 0));
+            nodes->endStruct();
+
+            addBuffer(column.validity, hasNulls ? (length + 7) / 8 : 0);
+            if (column.type == ColumnType::Utf8)
+            {
+                addBuffer(column.offsets, column.offsets ? (length + 1) * sizeof(int32_t) : 0);
+            }
+
+            addBuffer(column.values, column.valuesBytes);
+        }
+
+        auto recordBatch = makeTable();
+        recordBatch->scalar(0, static_cast<int64_t>(numRows))
+                    .ref(1, nodes)
+                    .ref(2, buffers);
+
+        CountingSink out(sink);
+        if (isFile)
+        {
+            out.write(Magic, 6);
+            out.pad(2);
+        }
+
+        writeMessage(out, makeMessage(HeaderSchema, makeSchema(columns, metadata), 0));
+
+        const size_t batchOffset = out.position();
+        const auto batchMetaLength =
+            writeMessage(out, makeMessage(HeaderRecordBatch, recordBatch, bodyLength));
+
+        for (const auto& buffer : body)
+        {
+            out.write(buffer.data, buffer.size);
+            out.pad(padded(buffer.size) - buffer.size);
+        }
+
+        // End of stream
+        const uint32_t endOfStream[2] = {Continuation, 0};
+        out.write(endOfStream, sizeof(endOfStream));
+
+        if (isFile)
+        {
+            auto blocks = std::make_shared<FbStructVector>();
+            blocks->add(static_cast<int64_t>(batchOffset));
+            blocks->add(batchMetaLength);
+            blocks->pad(4);
+            blocks->add(static_cast<int64_t>(bodyLength));
+            blocks->endStruct();
+
+            FbTable footer;
+            footer.scalar(0, MetadataVersionV5)
+                  .ref(1, makeSchema(columns, metadata))
+                  .ref(2, std::make_shared<FbStructVector>())
+                  .ref(3, blocks);
+
+            const auto footerBytes = finish(footer);
+            const auto footerSize = static_cast<int32_t>(footerBytes.size());
+            out.write(footerBytes.data(), footerBytes.size());
+            out.write(&footerSize, sizeof(footerSize));
+            out.write(Magic, 6);
+        }
+    }
+}  // namespace arrow
+}  // namespace encoders
+}  // namespace bufr
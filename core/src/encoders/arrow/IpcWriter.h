@@ -0,0 +1,77 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace bufr {
+namespace encoders {
+namespace arrow {
+    /// \brief The Arrow types of the column values.
+    enum class ColumnType
+    {
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float32,
+        Float64,
+        Utf8
+    };
+
+    /// \brief Custom metadata (key, value) of a schema or of a field.
+    typedef std::vector<std::pair<std::string, std::string>> KeyValues;
+
+    /// \brief A column of a record batch. The buffers are referenced, not copied, so they have
+    ///        to stay alive until they are written.
+    struct IpcColumn
+    {
+        std::string name;
+        ColumnType type = ColumnType::Float32;
+
+        /// \brief Sizes of the (nested) fixed size lists that make up each row (ex: {15} for 15
+        ///        channels per location). Empty if each row is one value.
+        std::vector<int32_t> listSizes;
+
+        /// \brief Number of rows.
+        size_t length = 0;
+
+        /// \brief The values (or the UTF-8 bytes of the strings).
+        const void* values = nullptr;
+        size_t valuesBytes = 0;
+
+        /// \brief Where each string starts in the values (one more than the strings, Utf8 only).
+        const int32_t* offsets = nullptr;
+
+        /// \brief Validity bitmap of the values (bit i is 1 if value i is valid, least
+        ///        significant bit first). nullptr if all the values are valid.
+        const uint8_t* validity = nullptr;
+        size_t nullCount = 0;
+
+        KeyValues metadata;
+    };
+
+    /// \brief Receives the bytes as they are written.
+    typedef std::function<void(const void* data, size_t size)> IpcSink;
+
+    /// \brief Write columns in the Arrow IPC format: the schema, one record batch and the end of
+    ///        stream marker. The file format (Feather v2) adds the magic and the footer around
+    ///        them. The metadata flatbuffers are built by hand so no Arrow library is needed,
+    ///        and the column buffers are handed to the sink as they are (whether they are copied
+    ///        is up to the sink).
+    /// \param columns The columns (all with the same number of rows).
+    /// \param metadata Custom metadata for the schema.
+    /// \param isFile Write the file format instead of the stream format.
+    /// \param sink Where the bytes go.
+    void writeIpc(const std::vector<IpcColumn>& columns,
+                  const KeyValues& metadata,
+                  bool isFile,
+                  const IpcSink& sink);
+}  // namespace arrow
+}  // namespace encoders
+}  // namespace bufr
@@ -0,0 +1,330 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#include "DirectChunkWriter.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include "eckit/exception/Exceptions.h"
+
+namespace
+{
+    /// \brief Limit on the uncompressed size of the chunks that are compressed at a time.
+    const size_t BatchBytes = 64 * 1024 * 1024;
+
+    /// \brief Pipeline of a dataset if it can be written with direct chunk writes.
+    struct Pipeline
+    {
+        bool supported = false;
+        bool shuffle = false;
+        int level = 0;
+    };
+
+    Pipeline getPipeline(hid_t dcpl)
+    {
+        Pipeline pipeline;
+        if (H5Pget_layout(dcpl) != H5D_CHUNKED) return pipeline;
+
+        bool hasDeflate = false;
+        const int numFilters = H5Pget_nfilters(dcpl);
+        for (int filterIdx = 0; filterIdx < numFilters; ++filterIdx)
+        {
+            unsigned int flags = 0;
+            size_t numValues = 8;
+            unsigned int values[8] = {0};
+            const auto filter = H5Pget_filter2(dcpl, static_cast<unsigned>(filterIdx), &flags,
+                                               &numValues, values, 0, nullptr, nullptr);
+
+            // Shuffle has to come before deflate
+            if (filter == H5Z_FILTER_SHUFFLE && !hasDeflate && !pipeline.shuffle)
+            {
+                pipeline.shuffle = true;
+            }
+            else if (filter == H5Z_FILTER_DEFLATE && !hasDeflate)
+            {
+                hasDeflate = true;
+                pipeline.level = numValues > 0 ? static_cast<int>(values[0]) : 6;
+            }
+            else
+            {
+                return pipeline;
+            }
+        }
+
+        pipeline.supported = hasDeflate;
+        return pipeline;
+    }
+
+    /// \brief Byte shuffle (same as the HDF5 shuffle filter): byte j of element i goes to
+    ///        j * numElements + i.
+    void shuffleBytes(const unsigned char* src,
+                      unsigned char* dst,
+                      size_t numElements,
+                      size_t elementSize)
+    {
+        for (size_t byteIdx = 0; byteIdx < elementSize; ++byteIdx)
+        {
+            unsigned char* out = dst + byteIdx * numElements;
+            for (size_t elemIdx = 0; elemIdx < numElements; ++elemIdx)
+            {
+                out[elemIdx] = src[elemIdx * elementSize + byteIdx];
+            }
+        }
+    }
+
+    /// \brief Copy the part of the data that falls in a chunk into a chunk sized buffer (the
+    ///        rest is set to the fill value).
+    void gatherChunk(const unsigned char* data,
+                     const std::vector<hsize_t>& dims,
+                     const std::vector<hsize_t>& chunks,
+                     const std::vector<hsize_t>& start,
+                     size_t elementSize,
+                     const void* fillValue,
+                     unsigned char* chunk)
+    {
+        const size_t rank = dims.size();
+
+        size_t chunkElems = 1;
+        bool isPartial = false;
+        std::vector<size_t> extent(rank);
+        for (size_t dimIdx = 0; dimIdx < rank; ++dimIdx)
+        {
+            extent[dimIdx] = static_cast<size_t>(std::min(chunks[dimIdx],
+                                                          dims[dimIdx] - start[dimIdx]));
+            isPartial = isPartial || extent[dimIdx] < chunks[dimIdx];
+            chunkElems *= static_cast<size_t>(chunks[dimIdx]);
+        }
+
+        if (isPartial)
+        {
+            for (size_t idx = 0; idx < chunkElems; ++idx)
+            {
+                std::memcpy(chunk + idx * elementSize, fillValue, elementSize);
+            }
+        }
+
+        // Copy one run along the last dimension for every position in the other dimensions
+        std::vector<size_t> pos(rank, 0);
+        const size_t runBytes = extent[rank - 1] * elementSize;
+        while (true)
+        {
+            size_t srcIdx = 0;
+            size_t dstIdx = 0;
+            for (size_t dimIdx = 0; dimIdx < rank; ++dimIdx)
+            {
+                srcIdx = srcIdx * dims[dimIdx] + start[dimIdx] + pos[dimIdx];
+                dstIdx = dstIdx * chunks[dimIdx] + pos[dimIdx];
+            }
+
+            std::memcpy(chunk + dstIdx * elementSize, data + srcIdx * elementSize, runBytes);
+
+            // Next position (the last dimension is covered by the run)
+            size_t dimIdx = rank - 1;
+            while (dimIdx > 0)
+            {
+                --dimIdx;
+                if (++pos[dimIdx] < extent[dimIdx]) break;
+                pos[dimIdx] = 0;
+            }
+
+            if (dimIdx == 0 && pos[0] == 0) break;
+        }
+    }
+}  // namespace
+
+namespace bufr {
+namespace encoders {
+namespace netcdf {
+    DirectChunkWriter::DirectChunkWriter(const std::string& filePath) :
+      filePath_(filePath)
+    {
+    }
+
+    DirectChunkWriter::~DirectChunkWriter()
+    {
+        close();
+    }
+
+    void DirectChunkWriter::close()
+    {
+        if (file_ >= 0)
+        {
+            H5Fclose(file_);
+            file_ = -1;
+        }
+    }
+
+    void DirectChunkWriter::write(const std::string& datasetPath,
+                                  const void* data,
+                                  size_t size,
+                                  size_t elementSize)
+    {
+        if (file_ < 0)
+        {
+            file_ = H5Fopen(filePath_.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+            if (file_ < 0)
+            {
+                throw eckit::BadParameter("Could not open " + filePath_ + " to write chunks.");
+            }
+        }
+
+        const hid_t dataset = H5Dopen2(file_, datasetPath.c_str(), H5P_DEFAULT);
+        if (dataset < 0)
+        {
+            throw eckit::BadParameter("Could not find dataset " + datasetPath + " in " +
+                                      filePath_ + ".");
+        }
+
+        const hid_t space = H5Dget_space(dataset);
+        const int rank = H5Sget_simple_extent_ndims(space);
+        std::vector<hsize_t> dims(static_cast<size_t>(std::max(rank, 0)));
+        H5Sget_simple_extent_dims(space, dims.data(), nullptr);
+        H5Sclose(space);
+
+        const hid_t fileType = H5Dget_type(dataset);
+        const hid_t memType = H5Tget_native_type(fileType, H5T_DIR_DEFAULT);
+        const size_t typeSize = H5Tget_size(fileType);
+        H5Tclose(fileType);
+
+        // The parts of edge chunks outside the dataset get the fill value (like HDF5 does)
+        const hid_t dcpl = H5Dget_create_plist(dataset);
+        const auto pipeline = getPipeline(dcpl);
+        std::vector<hsize_t> chunks(dims.size());
+        std::vector<unsigned char> fillValue(typeSize, 0);
+        if (pipeline.supported)
+        {
+            H5Pget_chunk(dcpl, rank, chunks.data());
+
+            H5D_fill_value_t fillStatus;
+            H5Pfill_value_defined(dcpl, &fillStatus);
+            if (fillStatus != H5D_FILL_VALUE_UNDEFINED)
+            {
+                H5Pget_fill_value(dcpl, memType, fillValue.data());
+            }
+        }
+        H5Pclose(dcpl);
+
+        size_t numValues = 1;
+        for (const auto dim : dims) numValues *= static_cast<size_t>(dim);
+
+        if (typeSize != elementSize || numValues != size)
+        {
+            H5Tclose(memType);
+            H5Dclose(dataset);
+
+            std::ostringstream errStr;
+            errStr << "The data for " << datasetPath << " doesn't match the dataset.";
+            throw eckit::BadParameter(errStr.str());
+        }
+
+        if (!pipeline.supported || rank == 0)
+        {
+            if (size > 0)
+            {
+                H5Dwrite(dataset, memType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+            }
+
+            H5Tclose(memType);
+            H5Dclose(dataset);
+            return;
+        }
+
+        H5Tclose(memType);
+
+        // Count the chunks in each dimension
+        size_t numChunks = 1;
+        size_t chunkElems = 1;
+        std::vector<size_t> chunkCounts(dims.size());
+        for (size_t dimIdx = 0; dimIdx < dims.size(); ++dimIdx)
+        {
+            chunkCounts[dimIdx] = static_cast<size_t>((dims[dimIdx] + chunks[dimIdx] - 1) /
+                                                      chunks[dimIdx]);
+            numChunks *= chunkCounts[dimIdx];
+            chunkElems *= static_cast<size_t>(chunks[dimIdx]);
+        }
+
+        const size_t chunkBytes = chunkElems * elementSize;
+        const size_t batchSize = std::max<size_t>(1, BatchBytes / std::max<size_t>(chunkBytes, 1));
+
+        // Element offset of the start of a chunk (in each dimension)
+        auto chunkStart = [&chunkCounts, &chunks](size_t chunkIdx)
+        {
+            std::vector<hsize_t> start(chunks.size());
+            for (size_t dimIdx = chunks.size(); dimIdx-- > 0;)
+            {
+                start[dimIdx] = (chunkIdx % chunkCounts[dimIdx]) * chunks[dimIdx];
+                chunkIdx /= chunkCounts[dimIdx];
+            }
+
+            return start;
+        };
+
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        std::vector<std::vector<unsigned char>> compressed(std::min(batchSize, numChunks));
+        for (size_t batchStart = 0; batchStart < numChunks; batchStart += batchSize)
+        {
+            const size_t batchEnd = std::min(numChunks, batchStart + batchSize);
+            bool failed = false;
+
+            #pragma omp parallel
+            {
+                std::vector<unsigned char> chunk(chunkBytes);
+                std::vector<unsigned char> shuffled(pipeline.shuffle ? chunkBytes : 0);
+
+                #pragma omp for schedule(dynamic)
+                for (size_t chunkIdx = batchStart; chunkIdx < batchEnd; ++chunkIdx)
+                {
+                    gatherChunk(bytes, dims, chunks, chunkStart(chunkIdx), elementSize,
+                                fillValue.data(), chunk.data());
+
+                    const unsigned char* src = chunk.data();
+                    if (pipeline.shuffle && elementSize > 1 && chunkElems > 1)
+                    {
+                        shuffleBytes(chunk.data(), shuffled.data(), chunkElems, elementSize);
+                        src = shuffled.data();
+                    }
+
+                    auto& out = compressed[chunkIdx - batchStart];
+                    out.resize(compressBound(static_cast<uLong>(chunkBytes)));
+                    auto outSize = static_cast<uLongf>(out.size());
+                    if (compress2(out.data(), &outSize, src, static_cast<uLong>(chunkBytes),
+                                  pipeline.level) != Z_OK)
+                    {
+                        #pragma omp atomic write
+                        failed = true;
+                    }
+
+                    out.resize(outSize);
+                }
+            }
+
+            if (failed)
+            {
+                H5Dclose(dataset);
+                throw eckit::BadParameter("Failed to compress the chunks of " + datasetPath +
+                                          ".");
+            }
+
+            // HDF5 calls are serial
+            for (size_t chunkIdx = batchStart; chunkIdx < batchEnd; ++chunkIdx)
+            {
+                const auto& out = compressed[chunkIdx - batchStart];
+                const auto start = chunkStart(chunkIdx);
+                if (H5Dwrite_chunk(dataset, H5P_DEFAULT, 0, start.data(), out.size(),
+                                   out.data()) < 0)
+                {
+                    H5Dclose(dataset);
+                    throw eckit::BadParameter("Failed to write the chunks of " + datasetPath +
+                                              ".");
+                }
+            }
+        }
+
+        H5Dclose(dataset);
+    }
+}  // namespace netcdf
+}  // namespace encoders
+}  // namespace bufr
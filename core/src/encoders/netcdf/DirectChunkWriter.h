@@ -0,0 +1,55 @@
+// (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+
+#pragma once
+
+#include <hdf5.h>
+
+#include <string>
+#include <vector>
+
+
+namespace bufr {
+namespace encoders {
+namespace netcdf {
+    /// \brief Writes the data of compressed (deflate with optional shuffle) datasets in a NetCDF-4
+    ///        file by compressing their chunks in parallel and writing the compressed chunks
+    ///        directly into the file (H5Dwrite_chunk). HDF5 would otherwise compress the chunks
+    ///        one at a time. The chunks are exactly what the dataset's own filters would produce,
+    ///        so the file reads like any other NetCDF-4 file.
+    class DirectChunkWriter
+    {
+     public:
+        /// \brief Constructor (the file is opened on the first write).
+        /// \param filePath Path of the NetCDF-4 file. It must not be open in NetCDF.
+        explicit DirectChunkWriter(const std::string& filePath);
+
+        ~DirectChunkWriter();
+
+        DirectChunkWriter(const DirectChunkWriter&) = delete;
+        DirectChunkWriter& operator=(const DirectChunkWriter&) = delete;
+
+        /// \brief Write all the data of a dataset. Datasets that are not chunked, or that use
+        ///        other filters, are written through HDF5 as usual.
+        /// \param datasetPath HDF5 path of the dataset (ex: /ObsValue/brightnessTemperature).
+        /// \param data The values in row major order (same type as the dataset).
+        template <typename T>
+        void write(const std::string& datasetPath, const std::vector<T>& data)
+        {
+            write(datasetPath, data.data(), data.size(), sizeof(T));
+        }
+
+        /// \brief Close the file (the destructor also does this).
+        void close();
+
+     private:
+        const std::string filePath_;
+        hid_t file_ = -1;
+
+        void write(const std::string& datasetPath,
+                   const void* data,
+                   size_t size,
+                   size_t elementSize);
+    };
+}  // namespace netcdf
+}  // namespace encoders
+}  // namespace bufr
@@ -2,20 +2,36 @@
 
 #include "bufr/encoders/netcdf/Encoder.h"
 
+#include <algorithm>
 #include <chrono>  // NOLINT
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
 #include <numeric>
 #include <map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 #include <netcdf>
+#include <netcdf_meta.h>
+#if defined(NC_HAS_ZSTD) || defined(NC_HAS_BLOSC)
+#include <netcdf_filter.h>
+#endif
+#if defined(NC_HAS_PARALLEL4) && NC_HAS_PARALLEL4
+#include <mpi.h>
+#include <netcdf_par.h>
+#endif
 
 #include "eckit/exception/Exceptions.h"
+#include "eckit/filesystem/PathName.h"
 
 #include "../../bufr/Log.h"
 #include "bufr/DataObject.h"
 #include "bufr/encoders/netcdf/NetcdfHelper.h"
+#include "DirectChunkWriter.h"
 
 namespace nc = netCDF;
 
@@ -25,6 +41,110 @@ namespace netcdf {
     static const char* LocationName = "Location";
     static const char* DefualtDimName = "dim";
 
+    // Smallest Location chunk length of appended files
+    static const size_t MinAppendChunk = 1024;
+
+    /// \brief Data writes that are deferred until all the metadata of the file is defined.
+    typedef std::vector<std::function<void()>> WriteQueue;
+
+    /// \brief The deferred writes of a file. Compressed variables go in directWrites when there
+    ///        is a chunkWriter. Those run once NetCDF has closed the file. When appending, the
+    ///        data is written after the locStart locations that are already in the file (the
+    ///        variables are only defined if the file is new). When the ranks of comm write the
+    ///        file together each rank's rows go at its own locStart, and the string variables
+    ///        (which HDF5 can't write in parallel) go in rootWrites for rank 0 to write once the
+    ///        file is closed.
+    struct WritePlan
+    {
+        WriteQueue writes;
+        WriteQueue directWrites;
+        std::vector<std::function<void(nc::NcFile&)>> rootWrites;
+        std::shared_ptr<DirectChunkWriter> chunkWriter;
+        const eckit::mpi::Comm* comm = nullptr;
+        bool append = false;
+        bool existingFile = false;
+        size_t locStart = 0;
+    };
+
+    /// \brief NetCDF file made in memory (NC_INMEMORY) whose file image can be taken when it is
+    ///        closed.
+    class MemoryImageFile : public nc::NcFile
+    {
+     public:
+        /// \brief Close the file and take over its bytes (the image NetCDF made, not a copy).
+        Encoder::FileImage closeToBytes()
+        {
+            NC_memio memio;
+            const int status = nc_close_memio(myId, &memio);
+            nullObject = true;  // Closed (even if it failed), so the destructor leaves it alone
+
+            if (status != NC_NOERR)
+            {
+                throw eckit::BadParameter(std::string("Could not get the NetCDF file image: ") +
+                                          nc_strerror(status));
+            }
+
+            // The memory now belongs to us (NetCDF allocated it with malloc)
+            Encoder::FileImage image;
+            image.data = std::shared_ptr<uint8_t>(static_cast<uint8_t*>(memio.memory), free);
+            image.size = memio.size;
+
+            return image;
+        }
+    };
+
+    /// \brief NetCDF-4 file that all the ranks of an MPI communicator create and write together
+    ///        (MPI-IO).
+    class ParallelFile : public nc::NcFile
+    {
+     public:
+        ParallelFile(const std::string& path, const eckit::mpi::Comm& comm)
+        {
+#if defined(NC_HAS_PARALLEL4) && NC_HAS_PARALLEL4
+            const int status = nc_create_par(path.c_str(),
+                                             NC_NETCDF4 | NC_CLOBBER | NC_MPIIO,
+                                             MPI_Comm_f2c(comm.communicator()),
+                                             MPI_INFO_NULL,
+                                             &myId);
+            if (status != NC_NOERR)
+            {
+                throw eckit::BadParameter("Could not create " + path + " for parallel writes: " +
+                                          nc_strerror(status));
+            }
+
+            nullObject = false;
+#else
+            throw eckit::BadParameter("Can't write " + path + " in parallel because NetCDF was "
+                                      "built without parallel I/O.");
+#endif
+        }
+    };
+
+    /// \brief Have all the ranks write the data of a variable together (compressed variables
+    ///        can only be written that way).
+    void setCollective(const nc::NcVar& var)
+    {
+#if defined(NC_HAS_PARALLEL4) && NC_HAS_PARALLEL4
+        nc_var_par_access(var.getParentGroup().getId(), var.getId(), NC_COLLECTIVE);
+#endif
+    }
+
+    /// \brief Find a variable of a file from the full name of its group (ex: /MetaData).
+    nc::NcVar findVar(const nc::NcFile& file,
+                      const std::string& groupPath,
+                      const std::string& name)
+    {
+        nc::NcGroup group = file;
+        std::istringstream pathStream(groupPath);
+        std::string groupName;
+        while (std::getline(pathStream, groupName, '/'))
+        {
+            if (!groupName.empty()) group = group.getGroup(groupName);
+        }
+
+        return group.getVar(name);
+    }
+
 
     template<typename T>
     struct is_vector : public std::false_type {};
@@ -86,20 +206,92 @@ namespace netcdf {
       }
     };
 
+    /// \brief Get the hyperslab that puts size elements of data at locStart along the first
+    ///        (Location) dimension of a variable.
+    void locationHyperslab(const nc::NcVar& var,
+                           size_t locStart,
+                           size_t size,
+                           std::vector<size_t>& start,
+                           std::vector<size_t>& count)
+    {
+        const auto dims = var.getDims();
+        start.assign(dims.size(), 0);
+        count.assign(dims.size(), 0);
+
+        size_t rowSize = 1;
+        for (size_t dimIdx = 1; dimIdx < dims.size(); dimIdx++)
+        {
+            count[dimIdx] = dims[dimIdx].getSize();
+            rowSize *= count[dimIdx];
+        }
+
+        start[0] = locStart;
+        count[0] = rowSize > 0 ? size / rowSize : 0;
+    }
+
     template <typename T>
     class VarWriter : public ObjectWriter<T>
     {
     public:
         VarWriter() = delete;
-        VarWriter(nc::NcVar& var) : var_(var) {}
+        VarWriter(const nc::NcVar& var) : var_(var) {}
+
+        /// \brief Writer that puts the data at locStart along the Location dimension.
+        /// \param collective All the ranks write together, so every rank has to write (even
+        ///        if it has no data).
+        VarWriter(const nc::NcVar& var, size_t locStart, bool collective = false) :
+          var_(var),
+          isAppend_(true),
+          locStart_(locStart),
+          collective_(collective)
+        {}
 
         void write(const std::vector<T>& data) final
         {
-            var_.putVar(data.data());
+            if (!isAppend_)
+            {
+                var_.putVar(data.data());
+                return;
+            }
+
+            std::vector<size_t> start;
+            std::vector<size_t> count;
+            locationHyperslab(var_, locStart_, data.size(), start, count);
+            if (!count.empty() && (count[0] > 0 || collective_))
+            {
+                const T empty = T();
+                var_.putVar(start, count, data.empty() ? &empty : data.data());
+            }
         }
 
     private:
-        nc::NcVar& var_;
+        const nc::NcVar var_;
+        const bool isAppend_ = false;
+        const size_t locStart_ = 0;
+        const bool collective_ = false;
+    };
+
+    /// \brief Writes the data of a compressed variable with compressed chunks (see
+    ///        DirectChunkWriter).
+    template <typename T>
+    class ChunkVarWriter : public ObjectWriter<T>
+    {
+    public:
+        ChunkVarWriter() = delete;
+        ChunkVarWriter(const std::shared_ptr<DirectChunkWriter>& writer,
+                       const std::string& datasetPath) :
+          writer_(writer),
+          datasetPath_(datasetPath)
+        {}
+
+        void write(const std::vector<T>& data) final
+        {
+            writer_->write(datasetPath_, data);
+        }
+
+    private:
+        const std::shared_ptr<DirectChunkWriter> writer_;
+        const std::string datasetPath_;
     };
 
     template <>
@@ -107,7 +299,14 @@ namespace netcdf {
     {
     public:
       VarWriter() = delete;
-      VarWriter(nc::NcVar& var) : var_(var) {}
+      VarWriter(const nc::NcVar& var) : var_(var) {}
+
+      VarWriter(const nc::NcVar& var, size_t locStart, bool collective = false) :
+        var_(var),
+        isAppend_(true),
+        locStart_(locStart),
+        collective_(collective)
+      {}
 
       void write(const std::vector<std::string>& data) final
       {
@@ -124,21 +323,219 @@ namespace netcdf {
           c_strs[i] = data[i].c_str();
         }
 
-        var_.putVar(c_strs.data());
+        if (!isAppend_)
+        {
+          var_.putVar(c_strs.data());
+          return;
+        }
+
+        std::vector<size_t> start;
+        std::vector<size_t> count;
+        locationHyperslab(var_, locStart_, data.size(), start, count);
+        if (!count.empty() && (count[0] > 0 || collective_))
+        {
+          const char* empty = "";
+          var_.putVar(start, count, c_strs.empty() ? &empty : c_strs.data());
+        }
       }
 
     private:
-      nc::NcVar& var_;
+      const nc::NcVar var_;
+      const bool isAppend_ = false;
+      const size_t locStart_ = 0;
+      const bool collective_ = false;
     };
 
+    /// \brief Make the writer for the data of a variable (appends, or writes this rank's rows,
+    ///        if the plan does).
+    template <typename T>
+    std::shared_ptr<ObjectWriter<T>> makeVarWriter(const nc::NcVar& var, const WritePlan& plan)
+    {
+        if (plan.comm)
+        {
+            setCollective(var);
+            return std::make_shared<VarWriter<T>>(var, plan.locStart, true);
+        }
+
+        if (plan.append)
+        {
+            return std::make_shared<VarWriter<T>>(var, plan.locStart);
+        }
+
+        return std::make_shared<VarWriter<T>>(var);
+    }
+
+    /// \brief Number of bytes each element of the object takes up in a NetCDF chunk.
+    size_t elementSize(const std::shared_ptr<DataObjectBase>& object, bool dictionary)
+    {
+        if (dictionary) return sizeof(int);
+
+        if (std::dynamic_pointer_cast<DataObject<double>>(object) ||
+            std::dynamic_pointer_cast<DataObject<int64_t>>(object) ||
+            std::dynamic_pointer_cast<DataObject<uint64_t>>(object))
+        {
+            return 8;
+        }
+
+        // Variable length strings are stored as references to the string data
+        if (std::dynamic_pointer_cast<DataObject<std::string>>(object)) return 16;
+
+        return 4;
+    }
+
+    /// \brief Shrink the chunk lengths of a variable's dimensions until one chunk of the variable
+    ///        is no bigger than targetBytes. The chunk lengths are shared by all the variables
+    ///        that use the dimensions, so their chunks line up. The first (Location) dimension
+    ///        is shrunk first since readers usually subset by location.
+    void fitChunks(std::map<std::string, size_t>& dimChunks,
+                   const std::vector<std::string>& dimNames,
+                   size_t elementSize,
+                   size_t targetBytes)
+    {
+        for (const auto& dimName : dimNames)
+        {
+            size_t chunkBytes = elementSize;
+            for (const auto& name : dimNames)
+            {
+                chunkBytes *= dimChunks[name];
+            }
+
+            if (chunkBytes <= targetBytes) break;
+
+            auto& chunk = dimChunks[dimName];
+            chunk = std::max<size_t>(1, targetBytes / (chunkBytes / chunk));
+        }
+    }
+
+    /// \brief Use the zstd or blosc filter for a variable if NetCDF (and the HDF5 filter plugin)
+    ///        supports it.
+    /// \return false if the filter is not available.
+    bool defineFilter(const nc::NcVar& var, const std::string& compressor, int level)
+    {
+        const int groupId = var.getParentGroup().getId();
+        const int varId = var.getId();
+
+        int status = NC_NOERR;
+        bool isDefined = false;
+
+#if defined(NC_HAS_ZSTD) && NC_HAS_ZSTD
+        if (compressor == "zstd" && nc_inq_filter_avail(groupId, H5Z_FILTER_ZSTD) == NC_NOERR)
+        {
+            status = nc_def_var_zstandard(groupId, varId, level);
+            isDefined = true;
+        }
+#endif
+
+#if defined(NC_HAS_BLOSC) && NC_HAS_BLOSC
+        if (compressor == "blosc" && nc_inq_filter_avail(groupId, H5Z_FILTER_BLOSC) == NC_NOERR)
+        {
+            status = nc_def_var_blosc(groupId, varId, BLOSC_LZ4, level, 0, BLOSC_SHUFFLE);
+            isDefined = true;
+        }
+#endif
+
+        // The filter is there, so a failure is a real error (not a reason to use deflate)
+        if (status != NC_NOERR)
+        {
+            std::ostringstream errStr;
+            errStr << "Could not use the " << compressor << " filter (level " << level << ") for ";
+            errStr << var.getName() << ": " << nc_strerror(status);
+            throw eckit::BadParameter(errStr.str());
+        }
+
+        return isDefined;
+    }
+
+    /// \brief Set up the compression of a variable. Float data can be quantized first (only
+    ///        the significant digits are kept) so it compresses better.
+    void setCompression(const nc::NcVar& var,
+                        const VariableDescription& varDesc,
+                        bool isFloatingPoint)
+    {
+        if (!varDesc.quantize.empty())
+        {
+            if (!isFloatingPoint)
+            {
+                std::ostringstream errStr;
+                errStr << "Variable " << varDesc.name << " can only be quantized if it has ";
+                errStr << "float or double data.";
+                throw eckit::BadParameter(errStr.str());
+            }
+
+#if defined(NC_HAS_QUANTIZE) && NC_HAS_QUANTIZE
+            static const std::map<std::string, int> QuantizeModes =
+                {{"bitgroom", NC_QUANTIZE_BITGROOM},
+                 {"granularbr", NC_QUANTIZE_GRANULARBR},
+                 {"bitround", NC_QUANTIZE_BITROUND}};
+
+            const int status = nc_def_var_quantize(var.getParentGroup().getId(),
+                                                   var.getId(),
+                                                   QuantizeModes.at(varDesc.quantize),
+                                                   varDesc.significantDigits);
+            if (status != NC_NOERR)
+            {
+                std::ostringstream errStr;
+                errStr << "Could not quantize " << varDesc.name << ": " << nc_strerror(status);
+                throw eckit::BadParameter(errStr.str());
+            }
+#else
+            log::warning() << "NetCDF does not support quantization, " << varDesc.name;
+            log::warning() << " will not be quantized." << std::endl;
+#endif
+        }
+
+        if (varDesc.compressionLevel <= 0) return;
+
+        if (varDesc.compressor != "deflate")
+        {
+            if (defineFilter(var, varDesc.compressor, varDesc.compressionLevel)) return;
+
+            log::warning() << "The " << varDesc.compressor << " filter is not available, ";
+            log::warning() << varDesc.name << " will use deflate instead." << std::endl;
+        }
+
+        var.setCompression(true, true, std::min(varDesc.compressionLevel, 9));
+    }
+
+    /// \brief Name of the group of a category when the categories are written as groups of one
+    ///        file (the category values joined by "_", ex: metop-a_amsua).
+    std::string categoryGroupName(const SubCategory& categories)
+    {
+        std::ostringstream groupName;
+        for (size_t catIdx = 0; catIdx < categories.size(); catIdx++)
+        {
+            if (catIdx > 0) groupName << "_";
+            groupName << categories[catIdx];
+        }
+
+        return groupName.str();
+    }
+
     template <typename T>
     nc::NcVar createVar(std::shared_ptr<DataObject<T>>& obj,
                         nc::NcGroup& group,
                         const std::string& name,
                         const std::vector<std::string>& dimNames,
                         std::vector<size_t>& chunks,
-                        const int compressionLevel)
+                        const VariableDescription& varDesc,
+                        WritePlan& plan)
     {
+        if (plan.existingFile)
+        {
+            auto var = group.getVar(name);
+            if (var.isNull() || var.getType().getId() != getNcType<T>().getId())
+            {
+                std::ostringstream errStr;
+                errStr << "Can't append " << varDesc.name << " because the file has no ";
+                errStr << "variable with that name and type.";
+                throw eckit::BadParameter(errStr.str());
+            }
+
+            auto writer = makeVarWriter<T>(var, plan);
+            plan.writes.push_back([obj, writer]() { obj->write(writer); });
+            return var;
+        }
+
         auto var = group.addVar(name, encoders::netcdf::getNcType<T>().getName(), dimNames);
 
         if (!chunks.empty())
@@ -146,13 +543,45 @@ namespace netcdf {
           var.setChunking(nc::NcVar::ChunkMode::nc_CHUNKED, chunks);
         }
 
-        if (compressionLevel > 0)
+        // Can not compress string data
+        constexpr bool isString = std::is_same<T, std::string>::value;
+        if (!isString)
         {
-          var.setCompression(true, true, compressionLevel);
+          setCompression(var, varDesc, std::is_floating_point<T>::value);
         }
 
         addAttribute(var, _FillValue, obj->missingValue());
-        obj->write(std::make_shared<VarWriter<T>>(var));
+
+        // Rank 0 gets all the strings and writes them on its own once the parallel file is closed
+        if (isString && plan.comm)
+        {
+            obj->gather(*plan.comm);
+
+            const auto groupPath = group.getName(true);
+            plan.rootWrites.push_back([obj, groupPath, name](nc::NcFile& file)
+                { obj->write(std::make_shared<VarWriter<T>>(findVar(file, groupPath, name))); });
+
+            return var;
+        }
+
+        // Only plain deflate can be written as compressed chunks (NetCDF does the quantization
+        // when the data is written)
+        if (plan.chunkWriter &&
+            !plan.append &&
+            !isString &&
+            varDesc.compressionLevel > 0 &&
+            varDesc.compressor == "deflate" &&
+            varDesc.quantize.empty())
+        {
+            auto writer = std::make_shared<ChunkVarWriter<T>>(plan.chunkWriter,
+                                                              group.getName(true) + "/" + name);
+            plan.directWrites.push_back([obj, writer]() { obj->write(writer); });
+        }
+        else
+        {
+            auto writer = makeVarWriter<T>(var, plan);
+            plan.writes.push_back([obj, writer]() { obj->write(writer); });
+        }
 
         return var;
     }
@@ -162,37 +591,37 @@ namespace netcdf {
                         const std::string& name,
                         const std::vector<std::string>& dimNames,
                         std::vector<size_t>& chunks,
-                        const int compressionLevel)
+                        const VariableDescription& varDesc,
+                        WritePlan& plan)
     {
         nc::NcVar var;
         if (auto fltobj = std::dynamic_pointer_cast<DataObject<float>>(object))
         {
-            var = createVar(fltobj, group, name, dimNames, chunks, compressionLevel);
+            var = createVar(fltobj, group, name, dimNames, chunks, varDesc, plan);
         }
         else if (auto dblobj = std::dynamic_pointer_cast<DataObject<double>>(object))
         {
-            var = createVar(dblobj, group, name, dimNames, chunks, compressionLevel);
+            var = createVar(dblobj, group, name, dimNames, chunks, varDesc, plan);
         }
         else if (auto intobj = std::dynamic_pointer_cast<DataObject<int32_t >>(object))
         {
-            var = createVar(intobj, group, name, dimNames, chunks, compressionLevel);
+            var = createVar(intobj, group, name, dimNames, chunks, varDesc, plan);
         }
         else if (auto uintobj = std::dynamic_pointer_cast<DataObject<uint32_t>>(object))
         {
-            var = createVar(uintobj, group, name, dimNames, chunks, compressionLevel);
+            var = createVar(uintobj, group, name, dimNames, chunks, varDesc, plan);
         }
         else if (auto int64obj = std::dynamic_pointer_cast<DataObject<int64_t>>(object))
         {
-            var = createVar(int64obj, group, name, dimNames, chunks, compressionLevel);
+            var = createVar(int64obj, group, name, dimNames, chunks, varDesc, plan);
         }
         else if (auto uint64obj = std::dynamic_pointer_cast<DataObject<uint64_t>>(object))
         {
-            var = createVar(uint64obj, group, name, dimNames, chunks, compressionLevel);
+            var = createVar(uint64obj, group, name, dimNames, chunks, varDesc, plan);
         }
         else if (auto strobj = std::dynamic_pointer_cast<DataObject<std::string>>(object))
         {
-            // Can not compress string data
-            var = createVar(strobj, group, name, dimNames, chunks, 0);
+            var = createVar(strobj, group, name, dimNames, chunks, varDesc, plan);
         }
         else
         {
@@ -202,6 +631,99 @@ namespace netcdf {
         return var;
     }
 
+    /// \brief Write a string object as integer codes plus a lookup table of the unique values.
+    ///        The lookup table gets its own dimension and variable (<name>_dictionary) in the
+    ///        same group and the codes variable references it with a "dictionary" attribute.
+    nc::NcVar createDictionaryVar(std::shared_ptr<DataObjectBase> object,
+                                  nc::NcGroup& group,
+                                  const std::string& name,
+                                  const std::vector<std::string>& dimNames,
+                                  std::vector<size_t>& chunks,
+                                  const VariableDescription& varDesc,
+                                  WritePlan& plan)
+    {
+        auto srcObj = std::dynamic_pointer_cast<DataObject<std::string>>(object);
+        if (!srcObj)
+        {
+            std::ostringstream errStr;
+            errStr << "Variable " << name << " can only use a dictionary with string data.";
+            throw eckit::BadParameter(errStr.str());
+        }
+
+        // The lookup table of each container would be different
+        if (plan.append)
+        {
+            std::ostringstream errStr;
+            errStr << "Variable " << name << " can't use a dictionary when appending.";
+            throw eckit::BadParameter(errStr.str());
+        }
+
+        // Encode a copy so that writing doesn't change how the caller's object stores its data
+        auto strObj = std::static_pointer_cast<DataObject<std::string>>(srcObj->copy());
+
+        // The lookup table has to be the same for all the ranks, so rank 0 gets all the data
+        if (plan.comm)
+        {
+            strObj->gather(*plan.comm);
+        }
+
+        strObj->encodeDictionary();
+
+        const auto dictName = name + "_dictionary";
+        const auto& dictionary = strObj->getDictionary();
+        size_t dictSize = dictionary.size();
+        if (plan.comm)
+        {
+            plan.comm->broadcast(dictSize, 0);
+        }
+
+        // A dimension of size 0 would be unlimited, so an empty dictionary (no values or all of
+        // them missing) gets one empty entry instead
+        auto dictDim = group.addDim(dictName, std::max<size_t>(dictSize, 1));
+        auto dictVar = group.addVar(dictName, nc::NcType::nc_STRING, dictDim);
+        const auto groupPath = group.getName(true);
+        if (plan.comm)
+        {
+            plan.rootWrites.push_back([strObj, groupPath, dictName](nc::NcFile& file)
+                {
+                    if (strObj->getDictionary().empty()) return;
+                    VarWriter<std::string>(findVar(file, groupPath, dictName))
+                        .write(strObj->getDictionary());
+                });
+        }
+        else if (!dictionary.empty())
+        {
+            plan.writes.push_back([strObj, dictVar]()
+                             { VarWriter<std::string>(dictVar).write(strObj->getDictionary()); });
+        }
+
+        auto var = group.addVar(name, getNcType<int>().getName(), dimNames);
+
+        if (!chunks.empty())
+        {
+          var.setChunking(nc::NcVar::ChunkMode::nc_CHUNKED, chunks);
+        }
+
+        setCompression(var, varDesc, false);
+
+        addAttribute(var, _FillValue, DataObject<std::string>::missingCode());
+        var.putAtt("dictionary", dictName);
+        if (plan.comm)
+        {
+            plan.rootWrites.push_back([strObj, groupPath, name](nc::NcFile& file)
+                {
+                    const auto& codes = strObj->getCodes();
+                    if (!codes.empty()) findVar(file, groupPath, name).putVar(codes.data());
+                });
+        }
+        else if (!strObj->getCodes().empty())
+        {
+          plan.writes.push_back([strObj, var]() { var.putVar(strObj->getCodes().data()); });
+        }
+
+        return var;
+    }
+
     Encoder::Encoder(const std::string &yamlPath) :
         description_(Description(yamlPath))
     {
@@ -221,6 +743,31 @@ namespace netcdf {
     Encoder::encode(const std::shared_ptr<DataContainer> &dataContainer,
                     const Encoder::Backend &backend,
                     bool append)
+    {
+        return encodeFiles(dataContainer, backend, append, nullptr);
+    }
+
+    std::map<SubCategory, std::shared_ptr<nc::NcFile>>
+    Encoder::encode(const std::shared_ptr<DataContainer> &dataContainer,
+                    const Encoder::Backend &backend,
+                    const eckit::mpi::Comm &comm)
+    {
+        if (backend.isMemoryFile || backend.categoriesAsGroups)
+        {
+            throw eckit::BadParameter("Parallel writes need a file on disk for each category.");
+        }
+
+        // The ranks pad and gather their objects, so they work on a container of their own
+        // (it shares the objects until they are replaced by padded copies)
+        auto rankContainer = std::make_shared<DataContainer>(*dataContainer);
+        return encodeFiles(rankContainer, backend, false, &comm);
+    }
+
+    std::map<SubCategory, std::shared_ptr<nc::NcFile>>
+    Encoder::encodeFiles(const std::shared_ptr<DataContainer> &dataContainer,
+                         const Encoder::Backend &backend,
+                         bool append,
+                         const eckit::mpi::Comm *comm)
     {
         auto startTime = std::chrono::steady_clock::now();
 
@@ -271,6 +818,24 @@ namespace netcdf {
             }
         }
 
+        // The one file that has a group for each category (categoriesAsGroups)
+        std::shared_ptr<nc::NcFile> groupsFile;
+        std::string groupsFileName;
+        if (backend.categoriesAsGroups)
+        {
+            if (append)
+            {
+                throw eckit::BadParameter("Can't append when writing the categories as groups.");
+            }
+
+            if (!findSubIdxs(backend.path).empty())
+            {
+                throw eckit::BadParameter("The output path can't have substitutions when the "
+                                          "categories are written as groups (the categories "
+                                          "become the group names).");
+            }
+        }
+
         // Got through each unique category
         for (const auto &categories: dataContainer->allSubCategories())
         {
@@ -280,8 +845,44 @@ namespace netcdf {
             auto dataObjectGroupBy = dataContainer->getGroupByObject(
                 description_.getVariables()[0].source, categories);
 
+            // When the ranks write together the Location dimension has the rows of all the ranks
+            // (the lower ranks' rows come first) and the other dimensions have to agree
+            const size_t numRows = dataObjectGroupBy->getDims()[0];
+            size_t numLocations = numRows;
+            size_t rankLocStart = 0;
+            if (comm)
+            {
+                std::vector<int> rankRows(comm->size());
+                comm->allGather(static_cast<int>(numRows), rankRows.begin(), rankRows.end());
+
+                numLocations = std::accumulate(rankRows.begin(), rankRows.end(), size_t(0));
+                rankLocStart = std::accumulate(rankRows.begin(),
+                                               rankRows.begin() + comm->rank(),
+                                               size_t(0));
+
+                // The aligned (padded) copies replace the originals in the encoder's own
+                // container, so the caller's objects keep this rank's data
+                std::set<std::string> sources;
+                for (const auto &dimDesc: description_.getDims())
+                {
+                    if (!dimDesc.source.empty()) sources.insert(dimDesc.source);
+                }
+
+                for (const auto &varDesc: description_.getVariables())
+                {
+                    sources.insert(varDesc.source);
+                }
+
+                for (const auto &source: sources)
+                {
+                    auto aligned = dataContainer->get(source, categories)->copy();
+                    aligned->alignDims(*comm);
+                    dataContainer->set(aligned, source, categories);
+                }
+            }
+
             // When we find that the primary index is zero we need to skip this category
-            if (dataObjectGroupBy->getDims()[0] == 0)
+            if (numLocations == 0)
             {
                 log::warning() << "Category (";
                 for (auto category: categories)
@@ -308,12 +909,15 @@ namespace netcdf {
             rootLocation.source = "";
             namedLocDims[{dataObjectGroupBy->getDimPaths()[0]}] = rootLocation;
 
-            // Create the dimension data for dimensions which include source data
+            // Create the dimension data for dimensions which include source data (a source with
+            // no rows only gives default values)
+            std::set<std::string> emptySourceDims;
             for (const auto &dimDesc: description_.getDims())
             {
                 if (!dimDesc.source.empty())
                 {
                     auto dataObject = dataContainer->get(dimDesc.source, categories);
+                    if (dataObject->size() == 0) emptySourceDims.insert(dimDesc.name);
 
                     // Validate the path for the source field makes sense for the dimension
                     if (std::find(dimDesc.paths.begin(),
@@ -371,6 +975,60 @@ namespace netcdf {
                 }
             }
 
+            // Get the dimension names of each variable
+            std::vector<std::vector<std::string>> varDimNames;
+            for (const auto &varDesc: description_.getVariables())
+            {
+                auto dataObject = dataContainer->get(varDesc.source, categories);
+
+                auto dimNames = std::vector<std::string>();
+                for (size_t dimIdx = 0; dimIdx < dataObject->getDims().size(); dimIdx++)
+                {
+                    auto dimPath = dataObject->getDimPaths()[dimIdx];
+                    const auto& namedPathDims = (dimIdx == 0) ? namedLocDims : namedExtraDims;
+                    dimNames.push_back(dimForDimPath(dimPath, namedPathDims).name);
+                }
+
+                varDimNames.push_back(dimNames);
+            }
+
+            // Choose one chunk length per dimension (whole dimensions unless the chunks of some
+            // variable would be bigger than the target size)
+            std::map<std::string, size_t> dimChunks;
+            for (const auto &dimPair: dimMap)
+            {
+                dimChunks[dimPair.first] = std::max<size_t>(dimPair.second->size(), 1);
+            }
+
+            // Appended files grow along Location, so its chunks can't come from the rows of the
+            // first write (which may have none). They start from as many (int sized) rows as fit
+            // in the target size (at least MinAppendChunk) and are fitted like the other
+            // dimensions.
+            dimChunks[LocationName] = std::max<size_t>(numLocations, 1);
+            if (append)
+            {
+                dimChunks[LocationName] =
+                    std::max<size_t>(description_.getChunkBytes() / sizeof(int), MinAppendChunk);
+            }
+
+            if (description_.getChunkBytes() > 0)
+            {
+                for (size_t varIdx = 0; varIdx < description_.getVariables().size(); varIdx++)
+                {
+                    // Variables that list their own chunks don't use the target size
+                    const auto& varDesc = description_.getVariables()[varIdx];
+                    if (!varDesc.chunks.empty()) continue;
+
+                    auto dataObject = dataContainer->get(varDesc.source, categories);
+                    fitChunks(dimChunks,
+                              varDimNames[varIdx],
+                              elementSize(dataObject, varDesc.dictionary),
+                              description_.getChunkBytes());
+                }
+
+                fitChunks(dimChunks, {LocationName}, sizeof(int), description_.getChunkBytes());
+            }
+
             // Make the categories
             size_t catIdx = 0;
             std::map<std::string, std::string> substitutions;
@@ -380,63 +1038,210 @@ namespace netcdf {
                 catIdx++;
             }
 
-            auto path = backend.path;
-            if (path.empty())
+            std::string fileName;
+            if (groupsFile)
             {
-                path = makePathPrototype(substitutions);
+                fileName = groupsFileName;
             }
+            else
+            {
+                // The file of all the categories doesn't depend on the category
+                const auto fileSubstitutions = backend.categoriesAsGroups ?
+                                                 std::map<std::string, std::string>() :
+                                                 substitutions;
+
+                auto path = backend.path;
+                if (path.empty())
+                {
+                    path = makePathPrototype(fileSubstitutions);
+                }
 
-            auto fileName = makeStrWithSubstitions(path, substitutions);
+                fileName = makeStrWithSubstitions(path, fileSubstitutions);
+            }
 
-            auto file = std::make_shared<nc::NcFile>();
-            if (backend.isMemoryFile)
+            // Define all the metadata (globals, dimensions, groups, variables and their attributes)
+            // first and queue up the data, so the file only goes from define mode to data mode
+            // once instead of for every variable.
+            WritePlan plan;
+            plan.append = append;
+            plan.existingFile = append && eckit::PathName(fileName).exists();
+            plan.comm = comm;
+            if (comm)
             {
-              file->create(fileName, NC_NETCDF4 | NC_CLOBBER | NC_DISKLESS);
+              plan.locStart = rankLocStart;
             }
-            else
+
+            const bool isSharedFile = groupsFile != nullptr;
+            std::shared_ptr<nc::NcFile> file = std::make_shared<nc::NcFile>();
+            if (backend.isMemoryImage)
             {
-              file->create(fileName, NC_NETCDF4 | NC_CLOBBER);
+              file = std::make_shared<MemoryImageFile>();
             }
 
-            // Create the Globals
-            for (auto &global: description_.getGlobals())
+            if (comm)
             {
-              std::shared_ptr<GlobalWriterBase> writer = nullptr;
-              if (auto intGlobal = std::dynamic_pointer_cast<GlobalDescription<int>>(global))
-              {
-                writer = std::make_shared<NcGlobalWriter<int>>(*file);
-              }
-              if (auto intGlobal =
-                std::dynamic_pointer_cast<GlobalDescription<std::vector<int>>>(global))
-              {
-                writer = std::make_shared<NcGlobalWriter<std::vector<int>>>(*file);
-              }
-              else if (auto floatGlobal =
-                std::dynamic_pointer_cast<GlobalDescription<float>>(global))
-              {
-                writer = std::make_shared<NcGlobalWriter<float>>(*file);
-              }
-              else if (auto floatGlobal =
-                std::dynamic_pointer_cast<GlobalDescription<std::vector<float>>>(global))
-              {
-                writer = std::make_shared<NcGlobalWriter<std::vector<float>>>(*file);
-              }
-              else if (auto doubleGlobal =
-                std::dynamic_pointer_cast<GlobalDescription<std::string>>(global))
+              file = std::make_shared<ParallelFile>(fileName, *comm);
+            }
+            else if (append && backend.isMemoryFile)
+            {
+              throw eckit::BadParameter("Can only append to NetCDF files on disk.");
+            }
+            else if (isSharedFile)
+            {
+              file = groupsFile;
+            }
+            else if (plan.existingFile)
+            {
+              file->open(fileName, nc::NcFile::write);
+
+              auto locDim = file->getDim(LocationName);
+              if (locDim.isNull() || !locDim.isUnlimited())
               {
-                writer = std::make_shared<NcGlobalWriter<std::string>>(*file);
+                std::ostringstream errStr;
+                errStr << "Can't append to " << fileName << " because its " << LocationName;
+                errStr << " dimension is not unlimited.";
+                throw eckit::BadParameter(errStr.str());
               }
 
-              global->writeTo(writer);
+              plan.locStart = locDim.getSize();
+            }
+            else if (backend.isMemoryFile)
+            {
+              // Files made with NC_INMEMORY (like nc_create_mem) hand back their image on close
+              const int memoryMode = backend.isMemoryImage ? NC_INMEMORY : NC_DISKLESS;
+              file->create(fileName, NC_NETCDF4 | NC_CLOBBER | memoryMode);
+            }
+            else
+            {
+              file->create(fileName, NC_NETCDF4 | NC_CLOBBER);
+            }
+
+            if (backend.categoriesAsGroups && !isSharedFile)
+            {
+                groupsFile = file;
+                groupsFileName = fileName;
             }
 
-            // Add Dimensions
+            // The group that holds the dimensions and variables of the category
+            nc::NcGroup root = *file;
+            if (backend.categoriesAsGroups && !categories.empty())
+            {
+                root = file->addGroup(categoryGroupName(categories));
+            }
+
+            if (description_.getParallelCompression() && !backend.isMemoryFile && !append && !comm)
+            {
+                plan.chunkWriter = std::make_shared<DirectChunkWriter>(fileName);
+            }
+
+            // Create the Globals (they are already in the file when appending to it or when an
+            // earlier category is in the same file)
+            if (!plan.existingFile && !isSharedFile)
+            {
+                for (auto &global: description_.getGlobals())
+                {
+                  std::shared_ptr<GlobalWriterBase> writer = nullptr;
+                  if (auto intGlobal = std::dynamic_pointer_cast<GlobalDescription<int>>(global))
+                  {
+                    writer = std::make_shared<NcGlobalWriter<int>>(*file);
+                  }
+                  if (auto intGlobal =
+                    std::dynamic_pointer_cast<GlobalDescription<std::vector<int>>>(global))
+                  {
+                    writer = std::make_shared<NcGlobalWriter<std::vector<int>>>(*file);
+                  }
+                  else if (auto floatGlobal =
+                    std::dynamic_pointer_cast<GlobalDescription<float>>(global))
+                  {
+                    writer = std::make_shared<NcGlobalWriter<float>>(*file);
+                  }
+                  else if (auto floatGlobal =
+                    std::dynamic_pointer_cast<GlobalDescription<std::vector<float>>>(global))
+                  {
+                    writer = std::make_shared<NcGlobalWriter<std::vector<float>>>(*file);
+                  }
+                  else if (auto doubleGlobal =
+                    std::dynamic_pointer_cast<GlobalDescription<std::string>>(global))
+                  {
+                    writer = std::make_shared<NcGlobalWriter<std::string>>(*file);
+                  }
+
+                  global->writeTo(writer);
+                }
+            }
+
+            // Add Dimensions (when appending the Location dimension is unlimited and the other
+            // dimensions must match the ones in the file)
             for (auto dimPair: dimMap)
             {
-                const auto& dim = file->addDim(dimPair.first, dimPair.second->size());
-                auto dimVar = file->addVar(dimPair.first, nc::NcType::nc_INT, dim);
+                const bool isLocation = dimPair.first == LocationName;
+                auto dimData = dimPair.second;
+
+                if (plan.existingFile)
+                {
+                    auto dim = root.getDim(dimPair.first);
+                    if (dim.isNull() || (!isLocation && dim.getSize() != dimData->size()))
+                    {
+                        std::ostringstream errStr;
+                        errStr << "Can't append to " << fileName << " because its ";
+                        errStr << dimPair.first << " dimension doesn't match the data.";
+                        throw eckit::BadParameter(errStr.str());
+                    }
+
+                    if (isLocation)
+                    {
+                        auto writer = makeVarWriter<int>(root.getVar(dimPair.first), plan);
+                        plan.writes.push_back([dimData, writer]() { dimData->write(writer); });
+                    }
+
+                    continue;
+                }
+
+                const auto& dim = (append && isLocation) ?
+                                    root.addDim(dimPair.first) :
+                                    root.addDim(dimPair.first,
+                                                isLocation ? numLocations : dimData->size());
+                auto dimVar = root.addVar(dimPair.first, nc::NcType::nc_INT, dim);
                 addAttribute(dimVar, _FillValue, DataObject<int>::missingValue());
-                dimPair.second->write(std::make_shared<VarWriter<int>>(dimVar));
+
+                if (description_.getChunkBytes() > 0)
+                {
+                    std::vector<size_t> dimVarChunks = {dimChunks[dimPair.first]};
+                    dimVar.setChunking(nc::NcVar::ChunkMode::nc_CHUNKED, dimVarChunks);
+                }
+
+                if ((append || comm) && isLocation)
+                {
+                    auto writer = makeVarWriter<int>(dimVar, plan);
+                    plan.writes.push_back([dimData, writer]() { dimData->write(writer); });
+                }
+                else if (comm)
+                {
+                    // The ranks with rows have the same values, so the first of them writes them
+                    // and the others write nothing (but still take part in the collective write)
+                    const int hasValues = emptySourceDims.count(dimPair.first) == 0 ? 1 : 0;
+                    std::vector<int> rankHasValues(comm->size());
+                    comm->allGather(hasValues, rankHasValues.begin(), rankHasValues.end());
+                    const auto writerRank = static_cast<size_t>(
+                        std::find(rankHasValues.begin(), rankHasValues.end(), 1) -
+                        rankHasValues.begin());
+
+                    setCollective(dimVar);
+                    auto writer = std::make_shared<VarWriter<int>>(dimVar, 0, true);
+                    if (writerRank == comm->rank())
+                    {
+                        plan.writes.push_back([dimData, writer]() { dimData->write(writer); });
+                    }
+                    else
+                    {
+                        plan.writes.push_back([writer]() { writer->write(std::vector<int>()); });
+                    }
+                }
+                else
+                {
+                    plan.writes.push_back([dimData, dimVar]()
+                                 { dimData->write(std::make_shared<VarWriter<int>>(dimVar)); });
+                }
             }
 
             for (const auto& dimDesc : description_.getDims())
@@ -464,85 +1269,53 @@ namespace netcdf {
                         continue;
                     }
 
-                    for (size_t dimIdx = 0; dimIdx < dataObject->getDims().size(); dimIdx++)
+                    // The values were already copied into the dimension data (written above)
+                    if (!std::dynamic_pointer_cast<DataObject<int>>(dataObject))
                     {
-                        auto dimPath = dataObject->getDimPaths()[dimIdx];
-
-                        NamedPathDims namedPathDims;
-                        if (dimIdx == 0)
-                        {
-                            namedPathDims = namedLocDims;
-                        }
-                        else
-                        {
-                            namedPathDims = namedExtraDims;
-                        }
-
-                        auto dimName = dimForDimPath(dimPath, namedPathDims).name;
-                        auto dimVar = file->getVar(dimName);
-
-                        if (const auto obj = std::dynamic_pointer_cast<DataObject<int>>(dataObject))
-                        {
-                            dimVar.putVar(obj->getRawData().data());
-                        }
-                        else
-                        {
-                            throw eckit::BadParameter("Dimension data type not supported.");
-                        }
-
-                        dimMap[dimName]->write(std::make_shared<VarWriter<int>>(dimVar));
+                        throw eckit::BadParameter("Dimension data type not supported.");
                     }
                 }
             }
 
             // Write all the other Variables
             std::set<std::string> groupNames;
-            for (const auto &varDesc: description_.getVariables())
+            for (size_t varIdx = 0; varIdx < description_.getVariables().size(); varIdx++)
             {
+                const auto& varDesc = description_.getVariables()[varIdx];
                 auto[groupName, varName] = splitName(varDesc.name);
-                if (groupNames.find(groupName) == groupNames.end())
+                if (!plan.existingFile && groupNames.find(groupName) == groupNames.end())
                 {
-                    file->addGroup(groupName);
+                    root.addGroup(groupName);
                     groupNames.insert(groupName);
                 }
 
-                auto group = file->getGroup(groupName);
+                auto group = root.getGroup(groupName);
+                if (group.isNull())
+                {
+                    std::ostringstream errStr;
+                    errStr << "Can't append to " << fileName << " because it has no group ";
+                    errStr << groupName << ".";
+                    throw eckit::BadParameter(errStr.str());
+                }
+
                 std::vector<size_t> chunks = {};
-                auto dimNames = std::vector<std::string>();
+                const auto& dimNames = varDimNames[varIdx];
                 auto dataObject = dataContainer->get(varDesc.source, categories);
                 for (size_t dimIdx = 0; dimIdx < dataObject->getDims().size(); dimIdx++)
                 {
-                    auto dimPath = dataObject->getDimPaths()[dimIdx];
-
-                    NamedPathDims namedPathDims;
-                    if (dimIdx == 0)
-                    {
-                        namedPathDims = namedLocDims;
-                    } else
-                    {
-                        namedPathDims = namedExtraDims;
-                    }
-
-                    dimNames.push_back(dimForDimPath(dimPath, namedPathDims).name);
-
-                    auto dimVar = group.getVar(dimForDimPath(dimPath, namedPathDims).name);
-
-                    auto dimChunk = static_cast<size_t>(dataObject->getDims()[dimIdx]);
-                    auto chunkMode = nc::NcVar::ChunkMode::nc_CHUNKED;
-                    if (!dimVar.isNull())
-                    {
-                      std::vector<size_t> varChunks;
-                      dimVar.getChunkingParameters(chunkMode, varChunks);
-                      dimChunk = varChunks[dimIdx];
-                    }
-
+                    // Explicit chunks (capped by the dimension size) take precedence
                     if (dimIdx < varDesc.chunks.size())
                     {
-                      chunks.push_back(std::min(dimChunk, varDesc.chunks[dimIdx]));
+                      // (an appended Location dimension is unlimited, so it doesn't cap them)
+                      auto dimSize = (dimIdx == 0) ?
+                                       (append ? varDesc.chunks[0] : numLocations) :
+                                       static_cast<size_t>(dataObject->getDims()[dimIdx]);
+                      chunks.push_back(std::max<size_t>(1, std::min(dimSize,
+                                                                    varDesc.chunks[dimIdx])));
                     }
                     else
                     {
-                      chunks.push_back(dimChunk);
+                      chunks.push_back(dimChunks[dimNames[dimIdx]]);
                     }
                 }
 
@@ -556,12 +1329,30 @@ namespace netcdf {
                     }
                 }
 
-                auto var = createVarFromObj(dataObject,
-                                            group,
-                                            varName,
-                                            dimNames,
-                                            chunks,
-                                            varDesc.compressionLevel);
+                nc::NcVar var;
+                if (varDesc.dictionary)
+                {
+                    var = createDictionaryVar(dataObject,
+                                              group,
+                                              varName,
+                                              dimNames,
+                                              chunks,
+                                              varDesc,
+                                              plan);
+                }
+                else
+                {
+                    var = createVarFromObj(dataObject,
+                                           group,
+                                           varName,
+                                           dimNames,
+                                           chunks,
+                                           varDesc,
+                                           plan);
+                }
+
+                // The attributes are already in the file when appending to it
+                if (plan.existingFile) continue;
 
                 var.putAtt("long_name", varDesc.longName);
                 if (!varDesc.units.empty())
@@ -581,6 +1372,48 @@ namespace netcdf {
                 }
             }
 
+            // Write all the data
+            if (!plan.existingFile)
+            {
+                file->enddef();
+            }
+
+            for (const auto& write : plan.writes)
+            {
+                write();
+            }
+
+            // The compressed chunks are written with HDF5 directly, so NetCDF has to let go of
+            // the file until they are done.
+            if (!plan.directWrites.empty())
+            {
+                file->close();
+                for (const auto& write : plan.directWrites)
+                {
+                    write();
+                }
+
+                plan.chunkWriter->close();
+                file->open(fileName, nc::NcFile::write);
+            }
+
+            // Rank 0 writes the strings once the ranks are done with the file
+            if (comm)
+            {
+                file->close();
+                if (comm->rank() == 0 && !plan.rootWrites.empty())
+                {
+                    nc::NcFile rootFile(fileName, nc::NcFile::write);
+                    for (const auto& write : plan.rootWrites)
+                    {
+                        write(rootFile);
+                    }
+                }
+
+                comm->barrier();
+                file = std::make_shared<nc::NcFile>(fileName, nc::NcFile::read);
+            }
+
             obsGroups.insert({categories, file});
         }
 
@@ -593,6 +1426,22 @@ namespace netcdf {
         return obsGroups;
     }
 
+    std::map<SubCategory, Encoder::FileImage>
+    Encoder::encodeToBytes(const std::shared_ptr<DataContainer> &dataContainer)
+    {
+        auto backend = Backend();
+        backend.isMemoryImage = true;
+
+        std::map<SubCategory, FileImage> images;
+        for (const auto& filePair : encode(dataContainer, backend))
+        {
+            auto file = std::static_pointer_cast<MemoryImageFile>(filePair.second);
+            images.emplace(filePair.first, file->closeToBytes());
+        }
+
+        return images;
+    }
+
     std::string Encoder::makeStrWithSubstitions(const std::string &prototype,
                                                 const std::map<std::string, std::string> &subMap)
     {
@@ -50,12 +50,36 @@ namespace bufr {
   template <>
   py::array pyArrayFromObj<std::string>(const std::shared_ptr<DataObject<std::string>>& obj)
   {
-    auto data = obj->getRawData();
-    py::list pyStrList(data.size());
+    py::list pyStrList(obj->size());
 
-    // Convert the std::vector<std::string> into a list of Python Unicode strings
-    for (size_t i = 0; i < data.size(); ++i) {
-      pyStrList[i] = py::str(data[i]);
+    if (obj->isDictionaryEncoded())
+    {
+      // Make one Python string per unique value and share it between all the rows using it.
+      const auto& codes = obj->getCodes();
+      const auto& dictionary = obj->getDictionary();
+
+      std::vector<py::str> pyDictionary(dictionary.size());
+      for (size_t i = 0; i < dictionary.size(); ++i) {
+        pyDictionary[i] = py::str(dictionary[i]);
+      }
+
+      py::str missing = py::str(DataObject<std::string>::missingValue());
+      for (size_t i = 0; i < codes.size(); ++i) {
+        if (codes[i] == DataObject<std::string>::missingCode()) {
+          pyStrList[i] = missing;
+        } else {
+          pyStrList[i] = pyDictionary[codes[i]];
+        }
+      }
+    }
+    else
+    {
+      const auto data = obj->getRawData();
+
+      // Convert the std::vector<std::string> into a list of Python Unicode strings
+      for (size_t i = 0; i < data.size(); ++i) {
+        pyStrList[i] = py::str(data[i]);
+      }
     }
 
     // Create a NumPy array of Python Unicode strings with the correct dimensions
@@ -66,7 +90,7 @@ namespace bufr {
     // Create the mask array
     py::array_t<bool> mask(obj->getDims());
     bool* maskPtr = static_cast<bool*>(mask.mutable_data());
-    for (size_t idx = 0; idx < data.size(); idx++)
+    for (size_t idx = 0; idx < obj->size(); idx++)
     {
       maskPtr[idx] = obj->isMissing(idx);
     }
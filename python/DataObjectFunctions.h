@@ -32,8 +32,25 @@ namespace bufr {
     // Create the mask array
     py::array_t<bool> mask(obj->getDims());
     bool* maskPtr = static_cast<bool*>(mask.mutable_data());
-    for (size_t idx = 0; idx < data.size(); idx++) {
-      maskPtr[idx] = obj->isMissing(idx);
+    if (obj->hasValidityBitmap()) {
+      // Unpack the validity bits, filling whole words of valid or missing values at once.
+      const auto& validity = obj->getValidityBitmap();
+      for (size_t word = 0; word < validity.size(); word++) {
+        const auto bits = validity[word];
+        const size_t start = word * 64;
+        const size_t end = std::min(start + 64, data.size());
+        if (bits == 0 || bits == ~uint64_t(0)) {
+          std::fill(maskPtr + start, maskPtr + end, bits == 0);
+        } else {
+          for (size_t idx = start; idx < end; idx++) {
+            maskPtr[idx] = !((bits >> (idx - start)) & 1);
+          }
+        }
+      }
+    } else {
+      for (size_t idx = 0; idx < data.size(); idx++) {
+        maskPtr[idx] = obj->isMissing(idx);
+      }
     }
 
     // Create a masked array from the data and mask arrays
@@ -60,7 +77,29 @@ namespace bufr {
                                   static_cast<const T*>(pyData.data()) + pyData.size());
 
     dataObj->setFieldName(fieldName);
-    dataObj->setData(std::move(strData));
+
+    // Masked arrays keep their mask as the validity bitmap (so masked elements don't need to
+    // hold the missing value and unmasked ones may).
+    py::object maModule = py::module::import("numpy").attr("ma");
+    if (py::cast<bool>(maModule.attr("isMaskedArray")(pyData)))
+    {
+      py::array_t<bool, py::array::c_style | py::array::forcecast> mask(
+        maModule.attr("getmaskarray")(pyData));
+      const bool* maskPtr = mask.data();
+
+      std::vector<uint64_t> validity((strData.size() + 63) / 64, 0);
+      for (size_t idx = 0; idx < strData.size(); idx++)
+      {
+        if (!maskPtr[idx]) validity[idx / 64] |= uint64_t(1) << (idx % 64);
+      }
+
+      dataObj->setData(std::move(strData), validity);
+    }
+    else
+    {
+      dataObj->setData(std::move(strData));
+    }
+
     dataObj->setDims(std::vector<int>(pyData.shape(), pyData.shape() + pyData.ndim()));
     dataObj->setDimPaths(std::vector<Query>(pyData.ndim()));
 
@@ -0,0 +1,2 @@
+
+from bufr.bufr_python.encoders.arrow import *
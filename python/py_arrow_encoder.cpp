@@ -0,0 +1,93 @@
+/*
+* (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+*
+* This software is licensed under the terms of the Apache Licence Version 2.0
+* which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+*/
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bufr/DataContainer.h"
+#include "bufr/encoders/Description.h"
+#include "bufr/encoders/arrow/Encoder.h"
+
+
+namespace py = pybind11;
+
+using bufr::DataContainer;
+using bufr::encoders::Description;
+using bufr::encoders::arrow::Encoder;
+
+namespace
+{
+  Encoder::Format formatFromStr(const std::string& format)
+  {
+    if (format == "file" || format == "feather") return Encoder::Format::File;
+    if (format == "stream") return Encoder::Format::Stream;
+
+    throw std::invalid_argument("Unknown Arrow IPC format " + format +
+                                " (must be file, feather or stream).");
+  }
+}  // namespace
+
+void setupArrowEncoder(py::module& m)
+{
+  py::class_<Encoder>(m, "Encoder")
+   .def(py::init<const std::string&>())
+   .def(py::init<const Description&>())
+   .def("encode", [](Encoder& self,
+                     const std::shared_ptr<DataContainer>& container,
+                     const std::string& path,
+                     const std::string& format) -> std::map<py::tuple, std::string>
+     {
+        if (path.empty())
+        {
+          throw std::invalid_argument("Encoder path string cannot be empty!");
+        }
+
+        std::map<py::tuple, std::string> pyPaths;
+        for (auto& [key, filePath] : self.encode(container, path, formatFromStr(format)))
+        {
+          pyPaths[py::cast(key)] = filePath;
+        }
+
+        return pyPaths;
+      },
+      py::arg("container"),
+      py::arg("path"),
+      py::arg("format") = "file",
+      "Encode the dataset into an Arrow IPC file for each category (read them with "
+      "pyarrow.feather.read_table or pyarrow.ipc.open_file) and get their paths")
+   .def("encode_to_bytes", [](Encoder& self,
+                              const std::shared_ptr<DataContainer>& container,
+                              const std::string& format)
+                              -> std::map<py::tuple, py::memoryview>
+     {
+        auto encodedData = self.encodeToBytes(container, formatFromStr(format));
+        std::map<py::tuple, py::memoryview> pyEncodedData;
+        for (auto& [key, data] : encodedData)
+        {
+          // Hand the bytes over to Python without copying them (the capsule owns them)
+          auto bytes = new std::vector<uint8_t>(std::move(data));
+          py::capsule owner(bytes, [](void* ptr)
+          {
+            delete static_cast<std::vector<uint8_t>*>(ptr);
+          });
+
+          py::array_t<uint8_t> array({bytes->size()}, {sizeof(uint8_t)}, bytes->data(), owner);
+          pyEncodedData.emplace(py::cast(key), py::memoryview(array));
+        }
+
+        return pyEncodedData;
+      },
+      py::arg("container"),
+      py::arg("format") = "stream",
+      "Encode the dataset into Arrow IPC data for each category (read it with "
+      "pyarrow.ipc.open_stream(data).read_all())");
+}
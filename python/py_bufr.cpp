@@ -15,6 +15,7 @@ void setupQuerySet(py::module& m);
 void setupResultSet(py::module& m);
 void setupEncoderDescription(py::module& m);
 void setupNetcdfEncoder(py::module& m);
+void setupArrowEncoder(py::module& m);
 void setupDataContainer(py::module& m);
 void setupDataCache(py::module& m);
 void setupMpi(py::module& m);
@@ -38,4 +39,7 @@ PYBIND11_MODULE(bufr_python, m)
 
   auto netcdf_encoder_m = encoder_m.def_submodule("netcdf", "NetCDF4 Encoder");
   setupNetcdfEncoder(netcdf_encoder_m);
+
+  auto arrow_encoder_m = encoder_m.def_submodule("arrow", "Arrow IPC Encoder");
+  setupArrowEncoder(arrow_encoder_m);
 }
@@ -135,5 +135,12 @@ void setupDataContainer(py::module& m)
           return self.gather(comm.getComm());
         },
         py::arg("comm"),
-        "Gather data from all processes.");
+        "Gather data from all processes.")
+   .def("distribute_categories", [](DataContainer& self, bufr::mpi::Comm& comm)
+        {
+          return self.distributeCategories(comm.getComm());
+        },
+        py::arg("comm"),
+        "Move every category onto one process (balanced by rows) so each process can encode "
+        "its own categories.");
 }
@@ -24,5 +24,19 @@ void setupEncoderDescription(py::module& m)
         py::arg("name"),
         py::arg("source"),
         py::arg("units"),
-        py::arg("longName") = "", "");
+        py::arg("longName") = "",
+        py::arg("dictionary") = false, "")
+   .def("set_chunk_bytes", &Description::setChunkBytes,
+        py::arg("chunk_bytes"),
+        "Set the target size in bytes of automatically sized chunks (0 for whole dimensions).")
+   .def("set_parallel_compression", &Description::setParallelCompression,
+        py::arg("parallel_compression"),
+        "Set whether compressed variables have their chunks compressed in parallel.")
+   .def("set_compression", &Description::setCompression,
+        py::arg("name"),
+        py::arg("compressor"),
+        py::arg("compression_level"),
+        py::arg("quantize") = "",
+        py::arg("significant_digits") = 0,
+        "Set the compressor, compression level and (optional) quantization of a variable.");
 }
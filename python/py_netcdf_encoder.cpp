@@ -7,13 +7,18 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 #include <pybind11/embed.h>
 
 #include <netcdf>
 
+#include <cstdint>
+#include <vector>
+
 #include "bufr/DataContainer.h"
 #include "bufr/encoders/Description.h"
 #include "bufr/encoders/netcdf/Encoder.h"
+#include "py_mpi.h"
 
 
 namespace py = pybind11;
@@ -23,6 +28,44 @@ using bufr::DataContainer;
 using bufr::encoders::Description;
 using bufr::encoders::netcdf::Encoder;
 
+namespace
+{
+  /// \brief Close the encoded files and open them again as netCDF4 Datasets (one for each
+  ///        category, the categories share one dataset when they are written as groups).
+  std::map<py::tuple, py::object>
+    makeDatasets(const std::map<bufr::SubCategory, std::shared_ptr<nc::NcFile>>& encodedData)
+  {
+    std::map<py::tuple, py::object> pyEncodedData;
+
+    // Ensure Python is initialized and import netCDF4
+    py::gil_scoped_acquire acquire;
+    py::module_ netCDF4 = py::module_::import("netCDF4");
+
+    py::dict kwargs;  // Dictionary to hold keyword arguments
+    kwargs["mode"] = "r";   // Read mode, adjust as necessary
+
+    std::map<nc::NcFile*, py::object> datasets;
+    for (auto& [key, value] : encodedData)
+    {
+      auto datasetIt = datasets.find(value.get());
+      if (datasetIt == datasets.end())
+      {
+        size_t pathLength;
+        char path[256];
+        nc_inq_path(value->getId(), &pathLength, path);
+        value->close();
+
+        auto dataset = netCDF4.attr("Dataset")(path, **kwargs);
+        datasetIt = datasets.insert({value.get(), dataset}).first;
+      }
+
+      pyEncodedData[py::cast(key)] = datasetIt->second;
+    }
+
+    return pyEncodedData;
+  }
+}  // namespace
+
 
 void setupNetcdfEncoder(py::module& m)
 {
@@ -31,7 +74,9 @@ void setupNetcdfEncoder(py::module& m)
    .def(py::init<const Description&>())
    .def("encode", [](Encoder& self,
                      const std::shared_ptr<DataContainer>& container,
-                     const std::string& path) -> std::map<py::tuple, py::object>
+                     const std::string& path,
+                     bool append,
+                     bool categoriesAsGroups) -> std::map<py::tuple, py::object>
      {
         if (path.empty())
         {
@@ -41,31 +86,58 @@ void setupNetcdfEncoder(py::module& m)
         auto backend = Encoder::Backend();
         backend.isMemoryFile = false;
         backend.path = path;
+        backend.categoriesAsGroups = categoriesAsGroups;
 
-        auto encodedData = self.encode(container, backend);
-        std::map<py::tuple, py::object> pyEncodedData;
-
-        // Ensure Python is initialized and import netCDF4
-        py::gil_scoped_acquire acquire;
-        py::module_ netCDF4 = py::module_::import("netCDF4");
+        return makeDatasets(self.encode(container, backend, append));
+      },
+      py::arg("container"),
+      py::arg("path"),
+      py::arg("append") = false,
+      py::arg("categoriesAsGroups") = false,
+      "Get the class to encode the dataset")
+   .def("encode", [](Encoder& self,
+                     const std::shared_ptr<DataContainer>& container,
+                     const std::string& path,
+                     bufr::mpi::Comm& comm) -> std::map<py::tuple, py::object>
+     {
+        if (path.empty())
+        {
+          throw std::invalid_argument("Encoder path string cannot be empty!");
+        }
 
-        py::dict kwargs;  // Dictionary to hold keyword arguments
-        kwargs["mode"] = "r";   // Read mode, adjust as necessary
+        auto backend = Encoder::Backend();
+        backend.isMemoryFile = false;
+        backend.path = path;
 
-        for (auto& [key, value] : encodedData)
+        return makeDatasets(self.encode(container, backend, comm.getComm()));
+      },
+      py::arg("container"),
+      py::arg("path"),
+      py::arg("comm"),
+      "Encode the rows of every rank into the same files (needs NetCDF with parallel I/O). "
+      "The container is not changed.")
+   .def("encode_to_bytes", [](Encoder& self,
+                              const std::shared_ptr<DataContainer>& container)
+                              -> std::map<py::tuple, py::memoryview>
+     {
+        auto images = self.encodeToBytes(container);
+        std::map<py::tuple, py::memoryview> pyImages;
+        for (auto& [key, image] : images)
         {
-          size_t pathLength;
-          char path[256];
-          nc_inq_path(value->getId(), &pathLength, path);
-          value->close();
+          // Hand NetCDF's image over to Python without copying it (the capsule keeps it alive)
+          auto owned = new Encoder::FileImage(std::move(image));
+          py::capsule owner(owned, [](void* ptr)
+          {
+            delete static_cast<Encoder::FileImage*>(ptr);
+          });
 
-          auto dataset = netCDF4.attr("Dataset")(path, **kwargs);
-          pyEncodedData[py::cast(key)] = dataset;
+          py::array_t<uint8_t> array({owned->size}, {sizeof(uint8_t)}, owned->data.get(), owner);
+          pyImages.emplace(py::cast(key), py::memoryview(array));
         }
 
-        return pyEncodedData;
+        return pyImages;
       },
       py::arg("container"),
-      py::arg("path"),
-      "Get the class to encode the dataset");
+      "Encode the dataset into in-memory NetCDF files and get their bytes (open them with "
+      "netCDF4.Dataset(name, memory=bytes))");
 }
@@ -6,6 +6,7 @@
 */
 
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 #include <memory>
 #include <vector>
@@ -29,16 +30,23 @@ void setupParser(py::module& m)
          py::arg("obsfile"),
          py::arg("mapping_path"),
          py::arg("table_path") = "")
-    .def("parse", [](BufrParser& self, size_t numMsgs = 0)
+    .def("parse", [](BufrParser& self,
+                     size_t numMsgs = 0,
+                     const std::vector<bufr::SubCategory>& categories = {})
          {
-           return self.parse(numMsgs);
+           return self.parse(numMsgs, categories);
          },
          py::arg("numMsgs") = 0,
-         "Get Parser to parse a config file and get the data container.")
-    .def("parse", [](BufrParser& self, bufr::mpi::Comm& comm)
+         py::arg("categories") = std::vector<bufr::SubCategory>(),
+         "Get Parser to parse a config file and get the data container. If categories are "
+         "given only the subsets that belong to them are parsed.")
+    .def("parse", [](BufrParser& self,
+                     bufr::mpi::Comm& comm,
+                     const std::vector<bufr::SubCategory>& categories = {})
         {
-          return self.parse(comm.getComm());
+          return self.parse(comm.getComm(), categories);
         },
         py::arg("comm"),
+        py::arg("categories") = std::vector<bufr::SubCategory>(),
         "Get Parser to parse a config file and get the data container in parallel.");
 }
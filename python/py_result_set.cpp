@@ -15,7 +15,9 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
+#include "bufr/Column.h"
 #include "bufr/DataObject.h"
+#include "bufr/EpochTime.h"
 #include "bufr/ResultSet.h"
 
 #include "DataObjectFunctions.h"
@@ -78,34 +80,44 @@ void setupResultSet(py::module& m)
            auto array    = py::array(py::dtype("datetime64[s]"), yearObj->getDims(), strides);
            auto arrayPtr = static_cast<int64_t*>(array.mutable_data());
 
-           for (size_t i = 0; i < yearObj->size(); ++i)
-           {
-             std::tm time;
-             time.tm_year  = yearObj->getAsInt(i) - 1900;
-             time.tm_mon   = monthObj->getAsInt(i) - 1;
-             time.tm_mday  = dayObj->getAsInt(i);
-             time.tm_hour  = hourObj->getAsInt(i);
-             time.tm_min   = minuteObj ? minuteObj->getAsInt(i) : 0;
-             time.tm_sec   = secondObj ? secondObj->getAsInt(i) : 0;
-             time.tm_isdst = 0;
-
-             arrayPtr[i] = static_cast<int64_t>(timegm(&time));
+           const auto years  = bufr::Column<int>(yearObj);
+           const auto months = bufr::Column<int>(monthObj);
+           const auto days   = bufr::Column<int>(dayObj);
+           const auto hours  = bufr::Column<int>(hourObj);
+
+           std::unique_ptr<bufr::Column<int>> minutes;
+           std::unique_ptr<bufr::Column<int>> seconds;
+           if (minuteObj) {
+             minutes = std::make_unique<bufr::Column<int>>(minuteObj);
            }
 
+           if (secondObj) {
+             seconds = std::make_unique<bufr::Column<int>>(secondObj);
+           }
+
+           bufr::secondsSinceEpoch(years.size(),
+                                   years.data(),
+                                   months.data(),
+                                   days.data(),
+                                   hours.data(),
+                                   minutes ? minutes->data() : nullptr,
+                                   seconds ? seconds->data() : nullptr,
+                                   arrayPtr);
+
            // Create the mask array
            py::object numpyModule = py::module::import("numpy");
 
            // Create the mask array
            py::array_t<bool> mask(yearObj->getDims());
            bool* maskPtr = static_cast<bool*>(mask.mutable_data());
-           for (size_t idx = 0; idx < yearObj->size(); idx++)
+           for (size_t idx = 0; idx < years.size(); idx++)
            {
-             maskPtr[idx] = yearObj->isMissing(idx) ||
-                            monthObj->isMissing(idx) ||
-                            dayObj->isMissing(idx) ||
-                            hourObj->isMissing(idx) ||
-                            (minuteObj ? minuteObj->isMissing(idx) : false) ||
-                            (secondObj ? secondObj->isMissing(idx) : false);
+             maskPtr[idx] = !(years.isValid(idx) &&
+                              months.isValid(idx) &&
+                              days.isValid(idx) &&
+                              hours.isValid(idx) &&
+                              (minutes ? minutes->isValid(idx) : true) &&
+                              (seconds ? seconds->isValid(idx) : true));
            }
 
            // Create a masked array from the data and mask arrays
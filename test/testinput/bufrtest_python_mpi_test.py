@@ -0,0 +1,178 @@
+# (C) Copyright 2024 NOAA/NWS/NCEP/EMC
+import sys
+
+import bufr
+import numpy as np
+from bufr.encoders import netcdf
+
+# Tells ctest the test was skipped (the test's SKIP_RETURN_CODE)
+SKIP_RETURN_CODE = 77
+
+
+def test_gather_validity(comm):
+    DATA_PATH = 'testinput/data/gdas.t18z.1bmhs.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_mhs_basic_mapping.yaml'
+
+    paths = bufr.Parser(DATA_PATH, YAML_PATH).parse().get_paths('variables/brightnessTemp')
+
+    # Every rank has a different number of rows and channels. The masked values hold the rank
+    # rather than the missing value, so only the validity can tell them apart.
+    rows = 3 + comm.rank()
+    channels = 2 + comm.rank()
+    mask = np.zeros((rows, channels), dtype=bool)
+    mask[0, :] = True
+    values = np.full((rows, channels), comm.rank(), dtype=np.int32)
+
+    container = bufr.DataContainer()
+    container.add('variables/values', np.ma.masked_array(values, mask=mask), paths)
+    container.gather(comm)
+
+    if comm.rank() == 0:
+        # Gathering pads the rows of the smaller ranks with missing values
+        max_channels = 2 + comm.size() - 1
+        expected = []
+        for rank in range(comm.size()):
+            rank_mask = np.ones((3 + rank, max_channels), dtype=bool)
+            rank_mask[1:, :2 + rank] = False
+            expected.append(rank_mask)
+
+        data = container.get('variables/values')
+        assert np.array_equal(np.ma.getmaskarray(data), np.concatenate(expected))
+
+
+def test_parallel_write(comm):
+    DATA_PATH = 'testinput/data/gdas.t18z.1bmhs.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_mhs_basic_mapping.yaml'
+    OUTPUT_PATH = 'testrun/bufrtest_python_parallel_write.nc'
+    SERIAL_OUTPUT_PATH = f'testrun/bufrtest_python_parallel_write_serial_{comm.rank()}.nc'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse(comm)
+    rank_data = {field: container.get(field).copy() for field in container.list()}
+
+    try:
+        parallel = next(iter(netcdf.Encoder(YAML_PATH).encode(container, OUTPUT_PATH, comm)
+                             .values()))
+    except Exception as e:
+        if 'without parallel I/O' in str(e):
+            return False  # NetCDF can't write in parallel, so there is nothing to check
+        raise
+
+    # The container still has this rank's own (unpadded, ungathered) data
+    assert sorted(container.list()) == sorted(rank_data.keys())
+    for field, data in rank_data.items():
+        assert container.get(field).shape == data.shape
+        assert np.ma.allequal(container.get(field), data)
+
+    # The file has the rows of all the ranks in rank order, the same as one rank writing them
+    full = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    serial = next(iter(netcdf.Encoder(YAML_PATH).encode(full, SERIAL_OUTPUT_PATH).values()))
+
+    for name in ['ObsValue/brightnessTemperature', 'MetaData/latitude', 'MetaData/dateTime']:
+        assert parallel[name].shape == serial[name].shape
+        assert np.ma.allequal(parallel[name][:], serial[name][:])
+
+    parallel.close()
+    serial.close()
+
+    return True
+
+
+def test_distribute_categories(comm):
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_amua_ta_mapping.yaml'
+    OUTPUT_PATH = f'testrun/amua_ta_distributed_{comm.rank()}_{{splits/satId}}.nc'
+
+    # Every rank reads the whole file to get the totals
+    full = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    categories = sorted(full.all_sub_categories())
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse(comm)
+    container.distribute_categories(comm)
+
+    # The owner has the rows of its category from every rank
+    owned = container.all_sub_categories()
+    assert all(category in categories for category in owned)
+    for category in owned:
+        for field in container.list():
+            assert container.get(field, category).shape == full.get(field, category).shape
+
+    # Gather the number of rows each rank has for every category (-1 if it doesn't own it) to
+    # check that the ranks' categories partition the full set
+    rows = np.full((1, len(categories)), -1, dtype=np.int32)
+    for category in owned:
+        rows[0, categories.index(category)] = container.get('variables/latitude', category).shape[0]
+
+    owners = bufr.DataContainer()
+    owners.add('variables/rows',
+               rows,
+               full.get_paths('variables/antennaTemperature', categories[0]))
+    owners.gather(comm)
+
+    if comm.rank() == 0:
+        rank_rows = owners.get('variables/rows')
+        assert rank_rows.shape == (comm.size(), len(categories))
+        for catIdx, category in enumerate(categories):
+            assert np.count_nonzero(rank_rows[:, catIdx] >= 0) == 1
+            assert rank_rows[:, catIdx].max() == full.get('variables/latitude', category).shape[0]
+
+    for dataset in netcdf.Encoder(YAML_PATH).encode(container, OUTPUT_PATH).values():
+        dataset.close()
+
+
+def test_parallel_write_empty_category(comm):
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_amua_ta_mapping.yaml'
+    OUTPUT_PATH = 'testrun/amua_ta_parallel_{splits/satId}.nc'
+    SERIAL_OUTPUT_PATH = f'testrun/amua_ta_parallel_serial_{comm.rank()}_{{splits/satId}}.nc'
+
+    # Split the rows of every category between the ranks, except that the last rank has none of
+    # the first category (so its Channel dimension source has no rows)
+    full = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    categories = sorted(full.all_sub_categories())
+
+    container = bufr.DataContainer(full.get_category_map())
+    for category in categories:
+        for field in full.list():
+            data = full.get(field, category)
+            rank_rows = np.array_split(np.arange(data.shape[0]), comm.size())
+            if category == categories[0]:
+                rank_rows = [np.arange(data.shape[0])] + [np.arange(0)] * (comm.size() - 1)
+
+            container.add(field,
+                          data[rank_rows[comm.rank()]],
+                          full.get_paths(field, category),
+                          category)
+
+    try:
+        parallel = netcdf.Encoder(YAML_PATH).encode(container, OUTPUT_PATH, comm)
+    except Exception as e:
+        if 'without parallel I/O' in str(e):
+            return False  # NetCDF can't write in parallel, so there is nothing to check
+        raise
+
+    # The dimension values come from a rank with rows, the same as one rank writing them
+    serial = netcdf.Encoder(YAML_PATH).encode(full, SERIAL_OUTPUT_PATH)
+    for category in categories:
+        parallel_dataset = parallel[tuple(category)]
+        serial_dataset = serial[tuple(category)]
+        for name in ['Channel', 'ObsValue/brightnessTemperature', 'MetaData/latitude']:
+            assert parallel_dataset[name].shape == serial_dataset[name].shape
+            assert np.ma.allequal(parallel_dataset[name][:], serial_dataset[name][:])
+
+    for dataset in list(parallel.values()) + list(serial.values()):
+        dataset.close()
+
+    return True
+
+
+if __name__ == '__main__':
+    bufr.mpi.App(sys.argv)
+    comm = bufr.mpi.Comm("world")
+
+    test_gather_validity(comm)
+    test_distribute_categories(comm)
+
+    ran_parallel_writes = [test_parallel_write(comm), test_parallel_write_empty_category(comm)]
+    if not all(ran_parallel_writes):
+        print('Skipping the parallel write test (NetCDF was built without parallel I/O).')
+        sys.exit(SKIP_RETURN_CODE)
@@ -1,9 +1,12 @@
 # (C) Copyright 2023 NOAA/NWS/NCEP/EMC
+import os
 import sys
 
 import bufr
 from bufr.encoders import netcdf
+from bufr.encoders import arrow
 import numpy as np
+import netCDF4
 
 
 def test_basic_query():
@@ -176,6 +179,128 @@ def test_highlevel_append():
     assert orig_data.shape == data.shape
     assert np.allclose(orig_data, data)
 
+def test_highlevel_append_encode():
+    DATA_PATH = 'testinput/data/gdas.t18z.1bmhs.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_mhs_basic_mapping.yaml'
+    OUTPUT_PATH = 'testrun/bufrtest_python_append_test.nc'
+
+    if os.path.exists(OUTPUT_PATH):
+        os.remove(OUTPUT_PATH)
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    data = container.get('variables/brightnessTemp')
+
+    encoder = netcdf.Encoder(YAML_PATH)
+    for _ in range(2):
+        for dataset in encoder.encode(container, OUTPUT_PATH, append=True).values():
+            dataset.close()
+
+    dataset = next(iter(encoder.encode(container, OUTPUT_PATH, append=True).values()))
+    obs_temp = dataset["ObsValue/brightnessTemperature"][:]
+    assert dataset.dimensions["Location"].isunlimited()
+    assert dataset.dimensions["Channel"].size == data.shape[1]
+    dataset.close()
+
+    assert obs_temp.shape == (3 * data.shape[0], data.shape[1])
+    assert np.ma.allequal(obs_temp, np.ma.concatenate((data, data, data)))
+
+def test_highlevel_validity():
+    DATA_PATH = 'testinput/data/gdas.t18z.1bmhs.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_mhs_basic_mapping.yaml'
+    SPLIT_DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    SPLIT_YAML_PATH = 'testinput/bufrtest_amua_ta_mapping.yaml'
+    OUTPUT_PATH = 'testrun/bufrtest_python_validity_test.nc'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    temps = container.get('variables/brightnessTemp')
+    paths = container.get_paths('variables/brightnessTemp')
+
+    # The mask is kept as the validity, so masked values don't need to hold the missing value
+    # and unmasked values may hold it
+    ids = np.arange(temps.size, dtype=np.int32).reshape(temps.shape)
+    ids[0, 0] = np.iinfo(np.int32).max
+    mask = np.zeros(temps.shape, dtype=bool)
+    mask[1::2, :] = True
+    container.add('variables/ids', np.ma.masked_array(ids, mask=mask), paths)
+
+    data = container.get('variables/ids')
+    assert np.array_equal(np.ma.getmaskarray(data), mask)
+    assert data[0, 0] == np.iinfo(np.int32).max
+
+    # Appending keeps the validity of both containers
+    appended = bufr.DataContainer()
+    appended.append(container)
+    appended.append(container)
+    assert np.array_equal(np.ma.getmaskarray(appended.get('variables/ids')),
+                          np.concatenate((mask, mask)))
+
+    # The encoder writes the missing value wherever the validity is unset
+    description = bufr.encoders.Description(YAML_PATH)
+    description.add_variable(name='MetaData/ids', source='variables/ids', units='1')
+
+    dataset = next(iter(netcdf.Encoder(description).encode(container, OUTPUT_PATH).values()))
+    obs_ids = dataset['MetaData/ids'][:]
+    dataset.close()
+
+    # NetCDF marks missing values by the _FillValue (the missing value), so the valid INT_MAX at
+    # [0, 0] can't be told apart from a missing value in the file
+    file_mask = mask.copy()
+    file_mask[0, 0] = True
+    assert np.array_equal(np.ma.getmaskarray(obs_ids), file_mask)
+    assert np.ma.getdata(obs_ids)[0, 0] == np.iinfo(np.int32).max
+    assert np.array_equal(np.ma.getdata(obs_ids)[~file_mask], ids[~file_mask])
+
+    # Splitting into categories slices the validity along with the rows
+    q = bufr.QuerySet()
+    q.add('satelliteIdentifier', '*/SAID')
+    q.add('antennaTemperature', '*/BRITCSTC/TMBR')
+    with bufr.File(SPLIT_DATA_PATH) as f:
+        r = f.execute(q)
+
+    sat_ids = r.get('satelliteIdentifier')
+    all_temps = r.get('antennaTemperature')
+
+    split = bufr.Parser(SPLIT_DATA_PATH, SPLIT_YAML_PATH).parse()
+    for category in split.all_sub_categories():
+        sat_id = split.get('variables/satelliteIdentifier', category)[0]
+        cat_temps = split.get('variables/antennaTemperature', category)
+        in_category = np.ma.filled(sat_ids == sat_id, False)
+        assert np.array_equal(np.ma.getmaskarray(cat_temps),
+                              np.ma.getmaskarray(all_temps[in_category]))
+
+def test_highlevel_append_chunks():
+    DATA_PATH = 'testinput/data/gdas.t18z.1bmhs.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_mhs_basic_mapping.yaml'
+    OUTPUT_PATH = 'testrun/bufrtest_python_append_chunks_test.nc'
+
+    if os.path.exists(OUTPUT_PATH):
+        os.remove(OUTPUT_PATH)
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+
+    # Start the file with a container that has no rows
+    empty = bufr.DataContainer()
+    for field in container.list():
+        empty.add(field, container.get(field)[:0], container.get_paths(field))
+
+    description = bufr.encoders.Description(YAML_PATH)
+    description.set_chunk_bytes(4096)
+
+    encoder = netcdf.Encoder(description)
+    for data in [empty, container]:
+        for dataset in encoder.encode(data, OUTPUT_PATH, append=True).values():
+            dataset.close()
+
+    # The Location chunks come from the target size (the 8 byte dateTime is the biggest value
+    # per location) rather than from the rows of the first write. Explicit chunks are kept.
+    dataset = netCDF4.Dataset(OUTPUT_PATH)
+    assert dataset['MetaData/dateTime'].chunking() == [4096 // 8]
+    assert dataset['MetaData/latitude'].chunking() == [4096 // 8]
+    assert dataset['Location'].chunking() == [4096 // 8]
+    assert dataset['ObsValue/brightnessTemperature'].chunking() == [1000, 5]
+    assert dataset.dimensions['Location'].size == container.get('variables/latitude').shape[0]
+    dataset.close()
+
 def test_highlevel_w_category():
     DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
     YAML_PATH = 'testinput/bufrtest_amua_ta_mapping.yaml'
@@ -201,6 +326,353 @@ def test_highlevel_w_category():
 
         assert np.allclose(obs_orig, obs_new)
 
+def test_highlevel_categories_as_groups():
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_amua_ta_mapping.yaml'
+    OUTPUT_PATH = 'testrun/bufrtest_python_groups_test.nc'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+
+    datasets = netcdf.Encoder(YAML_PATH).encode(container, OUTPUT_PATH, categoriesAsGroups=True)
+    dataset = next(iter(datasets.values()))
+    assert all(d is dataset for d in datasets.values())
+
+    for category in container.all_sub_categories():
+        data = container.get('variables/antennaTemperature', category)
+        group = dataset['_'.join(category)]
+        obs_temp = group['ObsValue/brightnessTemperature'][:]
+
+        assert group.dimensions['Location'].size == data.shape[0]
+        assert np.ma.allequal(obs_temp, data)
+
+    dataset.close()
+
+def test_highlevel_encode_to_bytes():
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_amua_ta_mapping.yaml'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+
+    images = netcdf.Encoder(YAML_PATH).encode_to_bytes(container)
+    assert len(images) == len(container.all_sub_categories())
+
+    for (category, image) in images.items():
+        data = container.get('variables/antennaTemperature', list(category))
+
+        dataset = netCDF4.Dataset('_'.join(category) + '.nc', memory=image)
+        obs_temp = dataset['ObsValue/brightnessTemperature'][:]
+        dataset.close()
+
+        assert np.ma.allequal(obs_temp, data)
+
+def test_highlevel_arrow():
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_amua_ta_mapping.yaml'
+    OUTPUT_PATH = 'testrun/bufrtest_python_test_{splits/satId}.arrow'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    encoder = arrow.Encoder(YAML_PATH)
+
+    streams = encoder.encode_to_bytes(container)
+    paths = encoder.encode(container, OUTPUT_PATH)
+    assert len(streams) == len(paths) == len(container.all_sub_categories())
+
+    for (category, path) in paths.items():
+        with open(path, 'rb') as arrow_file:
+            assert arrow_file.read(6) == b'ARROW1'
+
+        assert bytes(streams[category][:4]) == b'\xff\xff\xff\xff'
+
+    # pyarrow is optional, without it only the framing is checked
+    try:
+        import pyarrow.feather
+        import pyarrow.ipc
+    except ImportError:
+        print('Skipping the Arrow table checks (pyarrow is not available).')
+        return
+
+    for (category, path) in paths.items():
+        table = pyarrow.feather.read_table(path)
+        assert table.equals(pyarrow.ipc.open_stream(streams[category]).read_all())
+
+        data = container.get('variables/antennaTemperature', list(category))
+        field = table.schema.field('ObsValue/brightnessTemperature')
+        assert field.metadata[b'units'] == b'K'
+        assert field.type.list_size == data.shape[1]
+
+        values = table.column('ObsValue/brightnessTemperature').combine_chunks().flatten()
+        mask = values.is_null().to_numpy(zero_copy_only=False).reshape(data.shape)
+        values = values.to_numpy(zero_copy_only=False).reshape(data.shape)
+        assert np.all(mask == np.ma.getmaskarray(data))
+        assert np.allclose(values[~mask], data.compressed())
+
+def test_highlevel_dictionary():
+    DATA_PATH = 'testinput/data/rtma_ru.t0000z.adpsfc_nc000101.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_rtma_adpsfc_mapping.yaml'
+    OUTPUT_PATH = 'testrun/bufrtest_python_dictionary_test.nc'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    wigos_ids = container.get('variables/wigosidentifier')
+
+    description = bufr.encoders.Description(YAML_PATH)
+    description.add_variable(name='MetaData/stationWIGOSIdCodes',
+                             source='variables/wigosidentifier',
+                             units='',
+                             dictionary=True)
+
+    dataset = next(iter(netcdf.Encoder(description).encode(container, OUTPUT_PATH).values()))
+    plain = dataset["MetaData/stationWIGOSId"][:]
+    codes = dataset["MetaData/stationWIGOSIdCodes"][:]
+    lookup = dataset["MetaData/stationWIGOSIdCodes_dictionary"][:]
+    dataset.close()
+
+    assert len(lookup) == len(set(wigos_ids.compressed()))
+    decoded = np.array([lookup[c] if c is not np.ma.masked else '' for c in codes], dtype=object)
+    assert np.all(decoded == np.ma.filled(wigos_ids, ''))
+    assert np.all(decoded == plain)
+
+def test_highlevel_empty_dictionary():
+    DATA_PATH = 'testinput/data/rtma_ru.t0000z.adpsfc_nc000101.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_rtma_adpsfc_mapping.yaml'
+    OUTPUT_PATH = 'testrun/bufrtest_python_empty_dictionary_test.nc'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    wigos_ids = container.get('variables/wigosidentifier')
+    container.add('variables/missingIds',
+                  np.full(wigos_ids.shape, '', dtype='U1'),
+                  container.get_paths('variables/wigosidentifier'))
+
+    description = bufr.encoders.Description(YAML_PATH)
+    description.add_variable(name='MetaData/missingIds',
+                             source='variables/missingIds',
+                             units='',
+                             dictionary=True)
+
+    dataset = next(iter(netcdf.Encoder(description).encode(container, OUTPUT_PATH).values()))
+    lookup_dim = dataset['MetaData'].dimensions['missingIds_dictionary']
+    codes = dataset['MetaData/missingIds'][:]
+    dataset.close()
+
+    # An empty dictionary still gets a fixed size dimension (a size of 0 would be unlimited)
+    assert not lookup_dim.isunlimited()
+    assert lookup_dim.size == 1
+    assert np.all(np.ma.getmaskarray(codes))
+
+def test_highlevel_filters():
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_amua_ta_mapping.yaml'
+    FILTER_YAML_PATH = 'testinput/bufrtest_in_list_filter_mapping.yaml'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    sat_ids = np.concatenate([container.get('variables/satelliteIdentifier', cat)
+                              for cat in container.all_sub_categories()])
+    lats = np.concatenate([container.get('variables/latitude', cat)
+                           for cat in container.all_sub_categories()])
+    temps = np.concatenate([container.get('variables/antennaTemperature', cat)
+                            for cat in container.all_sub_categories()])
+
+    keep = np.ma.filled(np.isin(sat_ids, [3, 5]) & (lats >= 0) & (lats <= 45), False)
+
+    filtered = bufr.Parser(DATA_PATH, FILTER_YAML_PATH).parse()
+    filtered_ids = filtered.get('variables/satelliteIdentifier')
+    filtered_lats = filtered.get('variables/latitude')
+    filtered_temps = filtered.get('variables/antennaTemperature')
+
+    assert np.all(np.isin(filtered_ids, [3, 5]))
+    assert np.array_equal(np.sort(filtered_lats), np.sort(lats[keep]))
+    assert filtered_temps.shape == (np.count_nonzero(keep), temps.shape[1])
+
+def test_highlevel_transformed_filters():
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_amua_ta_mapping.yaml'
+    FILTER_YAML_PATH = 'testinput/bufrtest_transformed_filter_mapping.yaml'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    lats = np.concatenate([container.get('variables/latitude', cat)
+                           for cat in container.all_sub_categories()])
+
+    # The filters test the values before the transforms (-30 <= latitude <= 30) and after the
+    # type conversion (int(latitude) >= 0 keeps latitudes just below 0), the same whether they
+    # are tested while reading or on the exported rows
+    keep = np.ma.filled((lats >= -30) & (lats <= 30) & (np.trunc(lats) >= 0), False)
+    assert np.any(keep & np.ma.filled(lats < 0, False))
+
+    filtered = bufr.Parser(DATA_PATH, FILTER_YAML_PATH).parse()
+    filtered_lats = filtered.get('variables/latitude')
+
+    assert filtered_lats.shape[0] == np.count_nonzero(keep)
+    assert np.array_equal(np.sort(filtered_lats), np.sort(lats[keep]))
+    assert np.ma.allclose(filtered.get('variables/latitudeScaled'), filtered_lats * 2 + 10)
+
+def test_highlevel_empty_filters():
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_empty_filter_mapping.yaml'
+
+    # Every subset is rejected while reading, so there are no rows rather than a leftover one
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+
+    assert container.get('variables/latitude').shape[0] == 0
+    assert container.get('variables/antennaTemperature').shape[0] == 0
+    assert container.get('variables/antennaTemperature').ndim == 2
+
+def test_highlevel_categories():
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_amua_ta_mapping.yaml'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    subset = bufr.Parser(DATA_PATH, YAML_PATH).parse(categories=[['metop-a'], ['metop-c']])
+
+    assert sorted(subset.all_sub_categories()) == [['metop-a'], ['metop-c']]
+
+    # Only the split variable is collected before a subset is accepted, so check that all the
+    # other fields are collected for the subsets that are kept
+    assert sorted(subset.list()) == sorted(container.list())
+    for category in subset.all_sub_categories():
+        for field in container.list():
+            assert np.ma.allequal(subset.get(field, category), container.get(field, category))
+
+def test_highlevel_transformed_categories():
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_transformed_split_mapping.yaml'
+
+    # Requesting categories of a split on a transformed variable keeps all their rows
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    subset = bufr.Parser(DATA_PATH, YAML_PATH).parse(categories=[['metop-a'], ['metop-c']])
+
+    assert sorted(subset.all_sub_categories()) == [['metop-a'], ['metop-c']]
+    for category in subset.all_sub_categories():
+        assert subset.get('variables/latitude', category).shape[0] > 0
+        for field in container.list():
+            assert subset.get(field, category).shape == container.get(field, category).shape
+            assert np.ma.allequal(subset.get(field, category), container.get(field, category))
+
+    assert np.all(subset.get('variables/satelliteIdentifier', ['metop-a']) == 1004)
+
+def test_highlevel_expression():
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_expression_mapping.yaml'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    channels = container.get('variables/sensorChannelNumber')
+    temps = container.get('variables/antennaTemperature')
+    celsius = container.get('variables/antennaTemperatureCelsius')
+
+    expected = np.ma.masked_where(channels >= 4, temps - 273.15)
+    assert celsius.shape == temps.shape
+    assert np.array_equal(np.ma.getmaskarray(celsius), np.ma.getmaskarray(expected))
+    assert np.ma.allclose(celsius, expected)
+
+def test_highlevel_reduce():
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_reduce_mapping.yaml'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    temps = container.get('variables/antennaTemperature')
+
+    counts = container.get('variables/validChannelCount')
+    max_temps = container.get('variables/maxAntennaTemperature')
+    mean_temps = container.get('variables/meanAntennaTemperature')
+
+    assert counts.shape == max_temps.shape == mean_temps.shape == (temps.shape[0],)
+    assert np.array_equal(counts, np.ma.count(temps, axis=1))
+    assert np.ma.allclose(max_temps, np.ma.max(temps, axis=1))
+    assert np.ma.allclose(mean_temps, np.ma.mean(temps, axis=1), rtol=1e-5)
+
+def test_highlevel_parallel_compression():
+    DATA_PATH = 'testinput/data/gdas.t18z.1bmhs.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_mhs_basic_mapping.yaml'
+    OUTPUT_PATH = 'testrun/bufrtest_python_serial_compression_test.nc'
+    PARALLEL_OUTPUT_PATH = 'testrun/bufrtest_python_parallel_compression_test.nc'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+
+    description = bufr.encoders.Description(YAML_PATH)
+    description.set_parallel_compression(True)
+
+    serial = next(iter(netcdf.Encoder(YAML_PATH).encode(container, OUTPUT_PATH).values()))
+    parallel = next(iter(netcdf.Encoder(description)
+                         .encode(container, PARALLEL_OUTPUT_PATH).values()))
+
+    for name in ['ObsValue/brightnessTemperature', 'MetaData/latitude', 'MetaData/dateTime']:
+        assert parallel[name].filters() == serial[name].filters()
+        assert parallel[name].chunking() == serial[name].chunking()
+        assert np.ma.allequal(parallel[name][:], serial[name][:])
+
+    serial.close()
+    parallel.close()
+
+def test_highlevel_quantize():
+    DATA_PATH = 'testinput/data/gdas.t18z.1bmhs.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_mhs_basic_mapping.yaml'
+    OUTPUT_PATH = 'testrun/bufrtest_python_quantize_test.nc'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    data = container.get('variables/brightnessTemp')
+
+    description = bufr.encoders.Description(YAML_PATH)
+
+    # Levels outside the range of the compressor are rejected by the description
+    for compressor, level in [('blosc', 10), ('deflate', 10), ('zstd', 23)]:
+        try:
+            description.set_compression('ObsValue/brightnessTemperature', compressor, level)
+        except Exception:
+            continue
+        assert False, f"Did not throw exception for {compressor} compression level {level}."
+
+    for compressor in ['zstd', 'blosc']:
+        description.set_compression('ObsValue/brightnessTemperature', compressor, 4,
+                                    'bitround', 12)
+
+        dataset = next(iter(netcdf.Encoder(description).encode(container, OUTPUT_PATH).values()))
+        var = dataset["ObsValue/brightnessTemperature"]
+        obs_temp = var[:]
+
+        # The encoder only warns when the quantization or the filter isn't supported, so check
+        # that they were used when they are
+        if getattr(netCDF4, '__has_quantization_support__', False):
+            assert var.quantization() == (12, 'BitRound')
+
+        has_filter = {'zstd': lambda: (getattr(netCDF4, '__has_zstandard_support__', False)
+                                       and dataset.has_zstd_filter()),
+                      'blosc': lambda: (getattr(netCDF4, '__has_blosc_support__', False)
+                                        and dataset.has_blosc_filter())}
+        if has_filter[compressor]():
+            filters = var.filters()
+            assert filters[compressor]
+            assert not filters['zlib']
+            assert not filters['shuffle']
+
+        dataset.close()
+
+        # 12 significant bits keep the values to within 1 part in 4096
+        assert obs_temp.shape == data.shape
+        assert np.all(np.ma.getmaskarray(obs_temp) == np.ma.getmaskarray(data))
+        assert np.ma.allclose(obs_temp, data, rtol=1.0 / 4096)
+
+def test_highlevel_transforms():
+    DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
+    YAML_PATH = 'testinput/bufrtest_transforms_mapping.yaml'
+    INVALID_YAML_PATH = 'testinput/bufrtest_transforms_invalid_mapping.yaml'
+
+    container = bufr.Parser(DATA_PATH, YAML_PATH).parse()
+    fovn = container.get('variables/fieldOfViewNumber')
+    lats = container.get('variables/latitude')
+
+    # Integer fields give the same results as applying the steps one at a time
+    assert fovn.dtype == 'int32'
+    assert np.ma.allequal(container.get('variables/fieldOfViewNumberOffsetScaled'), fovn * 2)
+    assert np.ma.allequal(container.get('variables/fieldOfViewNumberScaledOffset'), fovn * 2 + 3)
+
+    # Floating point fields are scaled and offset in one step
+    assert np.ma.allclose(container.get('variables/latitudeOffsetScaled'), (lats + 0.5) * 2)
+
+    try:
+        bufr.Parser(DATA_PATH, INVALID_YAML_PATH).parse()
+    except Exception as e:
+        return
+
+    assert False, "Did not throw exception for scaling an integer field by a non-integer."
+
 def test_highlevel_cache():
     DATA_PATH = 'testinput/data/gdas.t12z.1bamua.tm00.bufr_d'
     YAML_PATH = 'testinput/bufrtest_amua_ta_mapping.yaml'
@@ -254,6 +726,24 @@ if __name__ == '__main__':
     test_highlevel_replace()
     test_highlevel_add()
     test_highlevel_w_category()
+    test_highlevel_categories_as_groups()
+    test_highlevel_encode_to_bytes()
+    test_highlevel_arrow()
     test_highlevel_cache()
     test_highlevel_append()
+    test_highlevel_append_encode()
+    test_highlevel_validity()
+    test_highlevel_append_chunks()
+    test_highlevel_dictionary()
+    test_highlevel_empty_dictionary()
+    test_highlevel_filters()
+    test_highlevel_transformed_filters()
+    test_highlevel_empty_filters()
+    test_highlevel_categories()
+    test_highlevel_transformed_categories()
+    test_highlevel_expression()
+    test_highlevel_reduce()
+    test_highlevel_transforms()
+    test_highlevel_parallel_compression()
+    test_highlevel_quantize()
     test_highlevel_mpi()
@@ -73,7 +73,8 @@ namespace mpi {
              const std::string& mappingFile,
              const std::string& outputFile,
              const std::string& tablePath = "",
-             std::size_t numMsgs = 0)
+             std::size_t numMsgs = 0,
+             bool categoriesAsGroups = false)
   {
     auto startTime = std::chrono::steady_clock::now();
 
@@ -85,7 +86,7 @@ namespace mpi {
       auto data = BufrParser(obsFile,
                              yaml->getSubConfiguration("bufr"), tablePath).parse(numMsgs);
 
-      auto backend = encoders::netcdf::Encoder::Backend(false, outputFile);
+      auto backend = encoders::netcdf::Encoder::Backend(false, outputFile, categoriesAsGroups);
 
       auto encoderConf = yaml->getSubConfiguration("encoder");
       encoders::netcdf::Encoder(encoderConf).encode(data, backend);
@@ -103,7 +104,10 @@ namespace mpi {
                        const std::string& mappingFile,
                        const std::string& outputFile,
                        const std::string& tablePath = "",
-                       bool separateFiles = false)
+                       bool separateFiles = false,
+                       bool categoriesAsGroups = false,
+                       bool distributeCategories = false,
+                       bool parallelWrite = false)
   {
     auto startTime = std::chrono::steady_clock::now();
 
@@ -115,14 +119,51 @@ namespace mpi {
       throw eckit::BadParameter("No section named \"encoder\"");
     }
 
+    if (distributeCategories && categoriesAsGroups)
+    {
+      throw eckit::BadParameter("Can't write the categories as groups of one file when the "
+                                "categories are distributed across the tasks.");
+    }
+
+    if (parallelWrite && categoriesAsGroups)
+    {
+      throw eckit::BadParameter("Can't write the categories as groups of one file when the "
+                                "tasks write in parallel.");
+    }
+
+    if (parallelWrite && (distributeCategories || separateFiles))
+    {
+      throw eckit::BadParameter("Parallel writes can't be combined with distributing the "
+                                "categories or writing a file for each task.");
+    }
+
     auto parser = BufrParser(obsFile, yaml->getSubConfiguration("bufr"), tablePath);
     auto data = parser.parse(comm);
 
-    if (separateFiles)
+    if (distributeCategories)
+    {
+      // Every task gets whole categories and writes their files
+      data->distributeCategories(comm);
+
+      auto backend = encoders::netcdf::Encoder::Backend(false, outputFile);
+
+      auto encoderConf = yaml->getSubConfiguration("encoder");
+      encoders::netcdf::Encoder(encoderConf).encode(data, backend);
+    }
+    else if (parallelWrite)
+    {
+      // All the tasks write their own rows into the same files
+      auto backend = encoders::netcdf::Encoder::Backend(false, outputFile);
+
+      auto encoderConf = yaml->getSubConfiguration("encoder");
+      encoders::netcdf::Encoder(encoderConf).encode(data, backend, comm);
+    }
+    else if (separateFiles)
     {
       auto backend = encoders::netcdf::Encoder::Backend(false,
                                                         outputFile + ".task_" +
-                                                        std::to_string(comm.rank()));
+                                                        std::to_string(comm.rank()),
+                                                        categoriesAsGroups);
 
       auto encoderConf = yaml->getSubConfiguration("encoder");
       encoders::netcdf::Encoder(encoderConf).encode(data, backend);
@@ -133,7 +174,7 @@ namespace mpi {
 
       if (comm.rank() == 0)
       {
-        auto backend = encoders::netcdf::Encoder::Backend(false, outputFile);
+        auto backend = encoders::netcdf::Encoder::Backend(false, outputFile, categoriesAsGroups);
 
         auto encoderConf = yaml->getSubConfiguration("encoder");
         encoders::netcdf::Encoder(encoderConf).encode(data, backend);
@@ -156,6 +197,12 @@ static void showHelp()
               << "Options:\n"
               << "  -h,  Show this help message\n"
               << "  --no-gather, Don't gather the data into 1 output file. Makes 1 file per task.\n"
+              << "  --category-groups, Write each category as a group of OUT_FILE instead of\n"
+              << "                     making a file per category.\n"
+              << "  --distribute, Move whole categories to the tasks and have each task write\n"
+              << "                the files of its categories (instead of gathering to 1 task).\n"
+              << "  --parallel-write, Have all the tasks write their own data into the same\n"
+              << "                    output files (parallel NetCDF-4).\n"
               << "  -t TABLE_PATH,  Path to BUFR table files (use with WMO BUFR files)\n"
               << "  -n NUM_MESSAGES,  Number of BUFR messages to parse.\n"
               << "Example:\n"
@@ -186,6 +233,9 @@ int main(int argc, char **argv)
     };
 
     bool separateFiles = false;
+    bool categoriesAsGroups = false;
+    bool distributeCategories = false;
+    bool parallelWrite = false;
     auto reqArgIdx = ReqArgType::ObsFile;
     std::size_t argIdx = 1;
     while (argIdx < static_cast<std::size_t> (argc))
@@ -222,6 +272,18 @@ int main(int argc, char **argv)
         {
           separateFiles = true;
           argIdx += 1;
+        } else if (strcmp(argv[argIdx], "--category-groups") == 0)
+        {
+          categoriesAsGroups = true;
+          argIdx += 1;
+        } else if (strcmp(argv[argIdx], "--distribute") == 0)
+        {
+          distributeCategories = true;
+          argIdx += 1;
+        } else if (strcmp(argv[argIdx], "--parallel-write") == 0)
+        {
+          parallelWrite = true;
+          argIdx += 1;
         } else
         {
             switch (reqArgIdx)
@@ -252,11 +314,14 @@ int main(int argc, char **argv)
                      mappingFile,
                      outputFile,
                      tablePath,
-                     separateFiles);
+                     separateFiles,
+                     categoriesAsGroups,
+                     distributeCategories,
+                     parallelWrite);
     }
     else
     {
-      bufr::parse(obsFile, mappingFile, outputFile, tablePath, numMsgs);
+      bufr::parse(obsFile, mappingFile, outputFile, tablePath, numMsgs, categoriesAsGroups);
     }
 
     return 0;